@@ -0,0 +1,218 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/**
+ * Measures the scheduled events and the wall-clock time of 10 simulated minutes with 10, 100 and
+ * 1,000 interface estimators (faces x prefixes), each of which is sent a probe every 100 ms (like a
+ * working face) or every 10 s (like an alternative that is only explored), whose Data returns
+ * after PROBE_RTT:
+ *
+ *  - timer: every estimator additionally has a refresh event every REFRESH_INTERVAL_IN_MS
+ *           (how InterfaceEstimation kept its windowed estimators up to date before),
+ *  - lazy:  the estimators advance on access (how InterfaceEstimation works now).
+ *
+ * The events run on a discrete event queue with a manual steady clock, standing in for the
+ * simulator. The refresh event reads the estimator, which advances it, so both variants do the
+ * same estimator work and differ only in the events.
+ */
+
+#include "fw/interface-estimation.hpp"
+#include <ndn-cxx/util/time-custom-clock.hpp>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <vector>
+
+namespace nfd {
+namespace fw {
+
+// The simulated time of one run (as in PIPS-scenario)
+const time::seconds SIMULATION_TIME(600);
+
+// The time the Data of a probe takes to return
+const time::milliseconds PROBE_RTT(20);
+
+// Keeps the compiler from optimizing the reads away
+volatile double g_sink;
+
+/**
+ * A steady clock that is set by the event queue.
+ */
+class ManualSteadyClock : public time::CustomSteadyClock
+{
+public:
+  time::steady_clock::TimePoint
+  getNow() const override
+  {
+    return m_now;
+  }
+
+  std::string
+  getSince() const override
+  {
+    return " since benchmark start";
+  }
+
+  boost::posix_time::time_duration
+  toPosixDuration(const time::steady_clock::Duration& duration) const override
+  {
+    return boost::posix_time::time_duration();
+  }
+
+  void
+  set(time::steady_clock::TimePoint now)
+  {
+    m_now = now;
+  }
+
+private:
+  time::steady_clock::TimePoint m_now;
+};
+
+/**
+ * A minimal discrete event queue (events at the same time run in the order they were scheduled).
+ */
+class EventQueue
+{
+public:
+  explicit
+  EventQueue(ManualSteadyClock& clock)
+    : m_clock(clock)
+    , m_nScheduled(0)
+  {
+  }
+
+  void
+  schedule(time::steady_clock::Duration delay, std::function<void()> callback)
+  {
+    m_events.push(Event{m_clock.getNow() + delay, m_nScheduled++, std::move(callback)});
+  }
+
+  void
+  run(time::steady_clock::TimePoint end)
+  {
+    while (!m_events.empty() && m_events.top().time <= end) {
+      Event event = m_events.top();
+      m_events.pop();
+      m_clock.set(event.time);
+      event.callback();
+    }
+  }
+
+  uint64_t
+  getScheduledEvents() const
+  {
+    return m_nScheduled;
+  }
+
+private:
+  struct Event
+  {
+    time::steady_clock::TimePoint time;
+    uint64_t order;
+    std::function<void()> callback;
+
+    bool
+    operator<(const Event& other) const
+    {
+      return time != other.time ? time > other.time : order > other.order;
+    }
+  };
+
+  ManualSteadyClock& m_clock;
+  std::priority_queue<Event> m_events;
+  uint64_t m_nScheduled;
+};
+
+/**
+ * Sends probes to all estimators and, if withTimers is set, refreshes each of them periodically.
+ *
+ * @returns the wall-clock time in milliseconds, and the scheduled events in nEvents.
+ */
+static double
+runEstimators(ManualSteadyClock& clock, int nEstimators, time::milliseconds probeInterval, bool withTimers,
+              uint64_t& nEvents)
+{
+  clock.set(time::steady_clock::TimePoint());
+  EventQueue events(clock);
+  std::vector<std::unique_ptr<InterfaceEstimation>> estimators;
+  std::vector<uint64_t> sequences(nEstimators, 0);
+  double sink = 0;
+
+  std::function<void(int)> sendProbe = [&] (int i) {
+    uint64_t sequence = sequences[i]++;
+    estimators[i]->addSentInterest(sequence);
+    sink += estimators[i]->getCurrentValue(RequirementType::LOSS);
+    events.schedule(PROBE_RTT, [&, i, sequence] {
+      estimators[i]->addSatisfiedInterest(1024, sequence);
+      estimators[i]->addRttMeasurement(PROBE_RTT);
+    });
+    events.schedule(probeInterval, [&, i] { sendProbe(i); });
+  };
+  std::function<void(int)> refresh = [&] (int i) {
+    sink += estimators[i]->getCurrentValue(RequirementType::BANDWIDTH);
+    events.schedule(time::milliseconds(InterfaceEstimation::REFRESH_INTERVAL_IN_MS), [&, i] { refresh(i); });
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < nEstimators; i++) {
+    estimators.emplace_back(new InterfaceEstimation());
+    // Spread the estimators over one probe interval, as faces and prefixes do not start in lockstep
+    events.schedule(probeInterval * i / nEstimators, [&, i] { sendProbe(i); });
+    if (withTimers) {
+      events.schedule(time::milliseconds(InterfaceEstimation::REFRESH_INTERVAL_IN_MS), [&, i] { refresh(i); });
+    }
+  }
+  events.run(time::steady_clock::TimePoint() + SIMULATION_TIME);
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+  g_sink = sink;
+  nEvents = events.getScheduledEvents();
+  return elapsed.count();
+}
+
+}  // namespace fw
+}  // namespace nfd
+
+int
+main(int argc, char* argv[])
+{
+  auto clock = std::make_shared<nfd::fw::ManualSteadyClock>();
+  ndn::time::setCustomClocks(clock);
+
+  std::cout << std::setw(12) << "probes [ms]" << std::setw(12) << "estimators" << std::setw(16) << "timer [events]"
+            << std::setw(15) << "lazy [events]" << std::setw(14) << "timer [ms]" << std::setw(13) << "lazy [ms]" << std::endl;
+  for (int probeInterval : {100, 10000})
+  {
+    for (int nEstimators : {10, 100, 1000})
+    {
+      uint64_t timerEvents = 0;
+      uint64_t lazyEvents = 0;
+      double timerMs = nfd::fw::runEstimators(*clock, nEstimators, nfd::time::milliseconds(probeInterval), true, timerEvents);
+      double lazyMs = nfd::fw::runEstimators(*clock, nEstimators, nfd::time::milliseconds(probeInterval), false, lazyEvents);
+      std::cout << std::setw(12) << probeInterval << std::setw(12) << nEstimators << std::setw(16) << timerEvents
+                << std::setw(15) << lazyEvents << std::fixed << std::setprecision(1)
+                << std::setw(14) << timerMs << std::setw(13) << lazyMs << std::endl;
+    }
+  }
+  return 0;
+}
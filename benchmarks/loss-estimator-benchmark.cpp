@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/**
+ * Measures the time the loss estimator of a face takes per probe, with 10, 100 and 1,000 probes
+ * outstanding within the Interest lifetime. Every probe is sent, one in ten is lost, one in ten is
+ * removed again (as if it was tainted) and the others are satisfied. The loss is read after every
+ * probe, and the estimator is updated every 100 probes.
+ *
+ * The steady clock is replaced by a manual one that advances by the same step for every probe,
+ * so the number of outstanding probes and the resulting loss (0.111) do not depend on the speed
+ * of the machine.
+ */
+
+#include "fw/loss-estimator-time-window.hpp"
+#include <ndn-cxx/util/time-custom-clock.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace nfd {
+namespace fw {
+
+// The lifetime of a probe and the window of the loss estimator (as in InterfaceEstimation)
+const time::milliseconds INTEREST_LIFETIME(2000);
+const time::milliseconds CALCULATION_WINDOW(5000);
+
+// The number of probes measured per run
+const int NUM_PROBES = 2000000;
+
+// The number of probes after which the estimator is updated
+const int UPDATE_INTERVAL = 100;
+
+// Keeps the compiler from optimizing the reads away
+volatile double g_sink;
+
+/**
+ * A steady clock that only advances when it is told to.
+ */
+class ManualSteadyClock : public time::CustomSteadyClock
+{
+public:
+  time::steady_clock::TimePoint
+  getNow() const override
+  {
+    return m_now;
+  }
+
+  std::string
+  getSince() const override
+  {
+    return " since benchmark start";
+  }
+
+  boost::posix_time::time_duration
+  toPosixDuration(const time::steady_clock::Duration& duration) const override
+  {
+    return boost::posix_time::time_duration();
+  }
+
+  void
+  advance(time::nanoseconds step)
+  {
+    m_now += step;
+  }
+
+private:
+  time::steady_clock::TimePoint m_now;
+};
+
+/**
+ * @returns the nanoseconds per probe, and the final loss estimate in loss.
+ */
+static double
+runLossEstimator(ManualSteadyClock& clock, int nOutstanding, double& loss)
+{
+  LossEstimatorTimeWindow estimator(INTEREST_LIFETIME, CALCULATION_WINDOW);
+
+  // Send one probe per step, so nOutstanding probes are pending within a second
+  time::nanoseconds step(1000000000LL / nOutstanding);
+  uint64_t sequence = 0;
+  for (; sequence < static_cast<uint64_t>(nOutstanding); sequence++)
+  {
+    estimator.addSentInterest(sequence);
+    clock.advance(step);
+  }
+
+  double sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_PROBES; i++, sequence++)
+  {
+    estimator.addSentInterest(sequence);
+
+    // Resolve the oldest outstanding probe: one in ten is lost, one in ten is removed
+    uint64_t oldest = sequence - nOutstanding + 1;
+    if (sequence % 10 == 1)
+    {
+      estimator.removeSentInterest(oldest);
+    }
+    else if (sequence % 10 != 0)
+    {
+      estimator.addSatisfiedInterest(oldest);
+    }
+    sink += estimator.getLossPercentage();
+
+    clock.advance(step);
+    if (i % UPDATE_INTERVAL == 0)
+    {
+      estimator.updateMeasurements();
+    }
+  }
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  g_sink = sink;
+
+  estimator.updateMeasurements();
+  loss = estimator.getLossPercentage();
+  return elapsed.count() / NUM_PROBES;
+}
+
+}  // namespace fw
+}  // namespace nfd
+
+int
+main(int argc, char* argv[])
+{
+  auto clock = std::make_shared<nfd::fw::ManualSteadyClock>();
+  ndn::time::setCustomClocks(clock);
+
+  std::cout << std::setw(12) << "outstanding" << std::setw(16) << "[ns/probe]" << std::setw(8) << "loss" << std::endl;
+  for (int nOutstanding : {10, 100, 1000})
+  {
+    double loss = 0;
+    double nsPerProbe = nfd::fw::runLossEstimator(*clock, nOutstanding, loss);
+    std::cout << std::setw(12) << nOutstanding << std::fixed
+              << std::setw(16) << std::setprecision(1) << nsPerProbe
+              << std::setw(8) << std::setprecision(3) << loss << std::endl;
+  }
+  return 0;
+}
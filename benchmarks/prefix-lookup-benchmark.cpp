@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/**
+ * Measures how many probes per second the lowest-cost strategy can resolve to the state of their
+ * prefix, with 1, 100 and 10,000 active prefixes:
+ *
+ *  - uriLookup:    the prefix is converted to a URI for every packet and the state is looked up by
+ *                  that string up to ten times (how afterReceiveInterest used its measurementMap),
+ *  - measurements: one longest prefix match in the measurements table, which holds the state of the
+ *                  prefix as strategy info (how findPrefixState() resolves it now).
+ *
+ * LowestCostStrategy::PrefixState is private, so the MeasurementInfo it wraps stands in for it.
+ */
+
+#include "fw/measurement-info.hpp"
+#include "table/measurements.hpp"
+#include "table/name-tree.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nfd {
+namespace fw {
+
+// The number of name components which are considered as prefix (PREFIX_OFFSET)
+const size_t PREFIX_OFFSET = 1;
+
+// The number of times afterReceiveInterest looked up the state of a probe by its prefix URI
+const int LOOKUPS_PER_PACKET = 10;
+
+// The number of probes resolved per run
+const int NUM_PACKETS = 2000000;
+
+// Keeps the compiler from optimizing the lookups away
+volatile FaceId g_sink;
+
+/**
+ * @returns the names of 10 probes of every prefix (/prefix<i>/probe/<sequence>), in random order.
+ */
+static std::vector<Name>
+makeProbeNames(int nPrefixes)
+{
+  std::vector<Name> names;
+  for (int i = 0; i < nPrefixes; i++)
+  {
+    for (uint64_t sequence = 0; sequence < 10; sequence++)
+    {
+      Name name("/prefix" + std::to_string(i));
+      name.append("probe").appendSequenceNumber(sequence);
+      names.push_back(name);
+    }
+  }
+  std::shuffle(names.begin(), names.end(), std::mt19937(42));
+  return names;
+}
+
+/**
+ * @returns the probes per second resolved by their prefix URI.
+ */
+static double
+runUriLookup(const std::vector<Name>& names)
+{
+  std::unordered_map<std::string, MeasurementInfo> measurementMap;
+  for (const Name& name : names)
+  {
+    measurementMap[name.getPrefix(PREFIX_OFFSET).toUri()];
+  }
+
+  FaceId sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_PACKETS; i++)
+  {
+    std::string currentPrefix = names[i % names.size()].getPrefix(PREFIX_OFFSET).toUri();
+    for (int lookup = 0; lookup < LOOKUPS_PER_PACKET; lookup++)
+    {
+      sink += measurementMap[currentPrefix].currentWorkingFaceId;
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  g_sink = sink;
+  return NUM_PACKETS / elapsed.count();
+}
+
+/**
+ * @returns the probes per second resolved by a longest prefix match in the measurements table.
+ */
+static double
+runMeasurementsLookup(const std::vector<Name>& names)
+{
+  NameTree nameTree;
+  Measurements measurements(nameTree);
+  for (const Name& name : names)
+  {
+    measurements.get(name.getPrefix(PREFIX_OFFSET)).insertStrategyInfo<MeasurementInfo>();
+  }
+
+  FaceId sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_PACKETS; i++)
+  {
+    measurements::Entry* me = measurements.findLongestPrefixMatch(names[i % names.size()],
+                                                                  measurements::EntryWithStrategyInfo<MeasurementInfo>());
+    sink += me->getStrategyInfo<MeasurementInfo>()->currentWorkingFaceId;
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  g_sink = sink;
+  return NUM_PACKETS / elapsed.count();
+}
+
+}  // namespace fw
+}  // namespace nfd
+
+int
+main(int argc, char* argv[])
+{
+  std::cout << std::setw(10) << "prefixes" << std::setw(20) << "uriLookup [pkt/s]"
+            << std::setw(24) << "measurements [pkt/s]" << std::setw(10) << "speedup" << std::endl;
+  for (int nPrefixes : {1, 100, 10000})
+  {
+    std::vector<nfd::Name> names = nfd::fw::makeProbeNames(nPrefixes);
+    double before = nfd::fw::runUriLookup(names);
+    double after = nfd::fw::runMeasurementsLookup(names);
+    std::cout << std::setw(10) << nPrefixes << std::fixed << std::setprecision(0)
+              << std::setw(20) << before << std::setw(24) << after
+              << std::setw(9) << std::setprecision(1) << after / before << "x" << std::endl;
+  }
+  return 0;
+}
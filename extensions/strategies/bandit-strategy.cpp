@@ -0,0 +1,475 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "bandit-strategy.hpp"
+#include "core/logger.hpp"
+#include "fw/algorithm.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT("BanditStrategy");
+
+const Name BanditStrategy::STRATEGY_NAME("ndn:/localhost/nfd/strategy/bandit/%FD%01/");
+NFD_REGISTER_STRATEGY(BanditStrategy);
+
+const double BanditStrategy::EXPLORATION_FACTOR = std::sqrt(2.0);
+
+BanditStrategy::BanditStrategy(Forwarder& forwarder, const Name& name)
+  : Strategy(forwarder, name)
+  , PREFIX_OFFSET(ParameterConfiguration::getInstance()->PREFIX_OFFSET)
+  , probeMatcher(ParameterConfiguration::getInstance()->PROBE_SUFFIX, PREFIX_OFFSET)
+  , tainterId(StrategyHelper::allocateTainterId())
+  , nLiveKnownPrefixes(0)
+{
+  beforeRemoveFaceConnection = this->beforeRemoveFace.connect([this] (Face& face) { beforeFaceRemoval(face.getId()); });
+}
+
+void BanditStrategy::afterReceiveInterest(const Face& inFace,
+                                          const Interest& interest,
+                                          const shared_ptr<pit::Entry>& pitEntry)
+{
+  const fib::NextHopList& nexthops = this->lookupFib(*pitEntry).getNextHops();
+  if (nexthops.empty())
+  {
+    NFD_LOG_DEBUG("No nexthop for " << interest.getName());
+    return;
+  }
+
+  PrefixState* state = findPrefixState(*pitEntry);
+  if (state == nullptr)
+  {
+    state = &insertPrefixState(*pitEntry, inFace, nexthops);
+  }
+  MeasurementInfo& mi = state->info;
+  const PrefixParameters& params = *state->parameters;
+
+  // The working face has been removed, so start over on the first usable nexthop
+  if (mi.currentWorkingFaceId == face::INVALID_FACEID)
+  {
+    for (const fib::NextHop& nexthop : nexthops)
+    {
+      if (isUsableArm(nexthop.getFace(), inFace, *pitEntry))
+      {
+        mi.currentWorkingFaceId = nexthop.getFace().getId();
+        break;
+      }
+    }
+  }
+
+  FaceId selectedOutFaceId = mi.currentWorkingFaceId;
+
+  // Probes are measured (and pull their arm) on the face they are finally sent on (see below)
+  bool isPull = false;
+  bool isMeasuredProbe = false;
+  bool isExploration = false;
+  uint64_t probeSequence = 0;
+
+  // Only probes update the working face and pull arms
+  if (probeMatcher.matches(interest.getName()))
+  {
+    updateWorkingFace(*state, inFace, nexthops, *pitEntry);
+    selectedOutFaceId = mi.currentWorkingFaceId;
+
+    // Tainted probes (of other routers) must not be redirected
+    if (!interest.isTainted())
+    {
+      probeSequence = StrategyHelper::getProbeSequence(interest.getName());
+      isPull = true;
+      isMeasuredProbe = true;
+
+      FaceId explorationFaceId = face::INVALID_FACEID;
+      if (params.taintingEnabled && nexthops.size() >= params.minNumOfFacesForTainting &&
+          ++state->probesSinceExploration >= params.maxTaintedProbesPercentage)
+      {
+        state->probesSinceExploration = 0;
+        explorationFaceId = selectExplorationArm(*state, inFace, nexthops, *pitEntry);
+      }
+      if (explorationFaceId != face::INVALID_FACEID)
+      {
+        // Taint the probe, so other routers don't use it for their measurements
+        // NOTE: const_cast is a hack and should generally be avoided!
+        Interest& nonConstInterest = const_cast<Interest&>(interest);
+        nonConstInterest.setTainted(true);
+        nonConstInterest.setTaintedBy(tainterId);
+        mi.myTaintedProbes.insert(probeSequence, time::steady_clock::now(), interest.getInterestLifetime());
+        selectedOutFaceId = explorationFaceId;
+        isExploration = true;
+
+        // Tell the previous routers to drop their measurements of this probe. Without the in-record
+        // removed by sendNack(), the Data of the probe is absorbed here.
+        lp::NackHeader nackHeader;
+        nackHeader.setReason(lp::NackReason::TAINTED);
+        this->sendNack(pitEntry, inFace, nackHeader);
+
+        NFD_LOG_INFO("Exploring face " << explorationFaceId << " of " << state->prefixUri << " with " << interest.getName());
+      }
+    }
+    else if (StrategyHelper::isTaintedBefore(*pitEntry, tainterId))
+    {
+      // This router is after the tainter, so the probe still measures the face it is sent on
+      probeSequence = StrategyHelper::getProbeSequence(interest.getName());
+      isMeasuredProbe = true;
+    }
+  }
+
+  // Never send an Interest back to where it came from
+  if (selectedOutFaceId == inFace.getId())
+  {
+    for (const fib::NextHop& nexthop : nexthops)
+    {
+      if (isUsableArm(nexthop.getFace(), inFace, *pitEntry))
+      {
+        selectedOutFaceId = nexthop.getFace().getId();
+        break;
+      }
+    }
+  }
+
+  // Do the bookkeeping only now, since the probe may have been moved away from its in-face
+  if (isPull)
+  {
+    state->stats.recordProbe(isExploration);
+    state->pulls[selectedOutFaceId]++;
+    state->nPulls++;
+  }
+  if (isMeasuredProbe)
+  {
+    mi.getOrCreateFaceInfo(selectedOutFaceId, params.bandwidthBuckets, params.bandwidthEwmaGain).addSentInterest(probeSequence);
+  }
+
+  for (const fib::NextHop& nexthop : nexthops)
+  {
+    if (nexthop.getFace().getId() == selectedOutFaceId)
+    {
+      this->sendInterest(pitEntry, nexthop.getFace(), interest);
+      NFD_LOG_DEBUG("Sending Interest " << interest.getName() << " on face " << selectedOutFaceId);
+      return;
+    }
+  }
+  NFD_LOG_WARN("Face " << selectedOutFaceId << " is no nexthop of " << interest.getName() << " anymore.");
+}
+
+void BanditStrategy::beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
+                                           const Face& inFace,
+                                           const Data& data)
+{
+  bool isProbe = probeMatcher.matches(data.getName());
+  if (!isProbe && !data.isPush())
+  {
+    return;
+  }
+  PrefixState* state = findPrefixState(*pitEntry);
+  if (state == nullptr)
+  {
+    return;
+  }
+  MeasurementInfo& mi = state->info;
+
+  if (!isProbe)
+  {
+    // Push data measures the bandwidth of its face passively
+    auto faceInfo = mi.faceInfoMap.find(inFace.getId());
+    if (faceInfo != mi.faceInfoMap.end())
+    {
+      faceInfo->second.addPassiveData(data.getContent().value_size());
+    }
+    return;
+  }
+
+  const uint64_t probeSequence = StrategyHelper::getProbeSequence(data.getName());
+  bool taintedByThisRouter = mi.myTaintedProbes.erase(probeSequence, time::steady_clock::now());
+
+  // Probes tainted by a router after this one are not measured here
+  if (!taintedByThisRouter && data.isTainted() && !StrategyHelper::isTaintedBefore(*pitEntry, tainterId))
+  {
+    return;
+  }
+
+  auto faceInfo = mi.faceInfoMap.find(inFace.getId());
+  if (faceInfo == mi.faceInfoMap.end())
+  {
+    return;
+  }
+  faceInfo->second.addSatisfiedInterest(data.getContent().value_size(), probeSequence);
+  if (taintedByThisRouter)
+  {
+    state->stats.recordAbsorbedProbe(data.wireEncode().size());
+  }
+
+  // Measure the RTT against the send time the forwarder stamped on the out-record of this face
+  // (the pit entry of an own tainted probe has no in-records, since the TAINTED Nack removed it)
+  pit::OutRecordCollection::const_iterator outRecord = pitEntry->getOutRecord(inFace);
+  if ((taintedByThisRouter || !pitEntry->getInRecords().empty()) && outRecord != pitEntry->getOutRecords().end())
+  {
+    const OutRecordInfo* outRecordInfo = outRecord->getStrategyInfo<OutRecordInfo>();
+    if (outRecordInfo != nullptr)
+    {
+      time::steady_clock::Duration rtt = time::steady_clock::now() - outRecordInfo->sendTime;
+      if (rtt <= time::milliseconds(state->parameters->rttTimeTableMaxDuration))
+      {
+        faceInfo->second.addRttMeasurement(time::duration_cast<time::microseconds>(rtt));
+      }
+    }
+  }
+}
+
+void BanditStrategy::afterReceiveNack(const Face& inFace,
+                                      const lp::Nack& nack,
+                                      const shared_ptr<pit::Entry>& pitEntry)
+{
+  if (nack.getReason() != lp::NackReason::TAINTED)
+  {
+    return;
+  }
+  PrefixState* state = findPrefixState(*pitEntry);
+  if (state == nullptr)
+  {
+    return;
+  }
+
+  // A router further upstream has tainted the probe, so it does not count for this router's measurements
+  auto faceInfo = state->info.faceInfoMap.find(inFace.getId());
+  if (faceInfo != state->info.faceInfoMap.end())
+  {
+    faceInfo->second.removeSentInterest(StrategyHelper::getProbeSequence(pitEntry->getInterest().getName()));
+  }
+  if (!pitEntry->getInRecords().empty())
+  {
+    this->sendNack(pitEntry, pitEntry->getInRecords().begin()->getFace(), nack.getHeader());
+  }
+}
+
+void BanditStrategy::printPathSelectionStats(std::ostream& os, const std::string& label)
+{
+  for (const Name& prefix : knownPrefixes)
+  {
+    measurements::Entry* me = this->getMeasurements().findExactMatch(prefix);
+    PrefixState* state = (me == nullptr) ? nullptr : me->getStrategyInfo<PrefixState>();
+    if (state != nullptr)
+    {
+      os << label << " strategy=bandit prefix=" << state->prefixUri << " ";
+      state->stats.print(os, time::steady_clock::now());
+      os << " taintedProbeSetBytes=" << state->info.myTaintedProbes.getMemoryUsage()
+         << " taintedProbeEvictions=" << state->info.myTaintedProbes.getEvictions() << std::endl;
+    }
+  }
+}
+
+void BanditStrategy::beforeFaceRemoval(FaceId faceId)
+{
+  for (auto it = knownPrefixes.begin(); it != knownPrefixes.end();)
+  {
+    measurements::Entry* me = this->getMeasurements().findExactMatch(*it);
+    PrefixState* state = (me == nullptr) ? nullptr : me->getStrategyInfo<PrefixState>();
+    if (state == nullptr)
+    {
+      it = knownPrefixes.erase(it);
+      continue;
+    }
+    if (state->info.currentWorkingFaceId == faceId)
+    {
+      state->info.currentWorkingFaceId = face::INVALID_FACEID;
+    }
+    state->info.faceInfoMap.erase(faceId);
+    auto pulls = state->pulls.find(faceId);
+    if (pulls != state->pulls.end())
+    {
+      state->nPulls -= pulls->second;
+      state->pulls.erase(pulls);
+    }
+    ++it;
+  }
+}
+
+void BanditStrategy::updateWorkingFace(PrefixState& state, const Face& inFace,
+                                       const fib::NextHopList& nexthops, const pit::Entry& pitEntry)
+{
+  MeasurementInfo& mi = state.info;
+
+  double currentReward = -1;
+  auto currentInfo = mi.faceInfoMap.find(mi.currentWorkingFaceId);
+  if (currentInfo != mi.faceInfoMap.end())
+  {
+    currentReward = getReward(currentInfo->second, mi.req);
+    state.stats.checkWorkingFace(currentInfo->second, mi.req, time::steady_clock::now());
+  }
+
+  FaceId bestFaceId = face::INVALID_FACEID;
+  double bestReward = 0;
+  for (const fib::NextHop& nexthop : nexthops)
+  {
+    FaceId faceId = nexthop.getFace().getId();
+    auto faceInfo = mi.faceInfoMap.find(faceId);
+    if (faceId == mi.currentWorkingFaceId || faceInfo == mi.faceInfoMap.end() ||
+        !isUsableArm(nexthop.getFace(), inFace, pitEntry))
+    {
+      continue;
+    }
+    double reward = getReward(faceInfo->second, mi.req);
+    if (reward > bestReward)
+    {
+      bestReward = reward;
+      bestFaceId = faceId;
+    }
+  }
+
+  // Keep an unmeasured working face until it has been measured
+  if (bestFaceId == face::INVALID_FACEID || currentReward < 0)
+  {
+    return;
+  }
+  if (currentReward == 0 || bestReward > currentReward * (1 + state.parameters->hysteresisPercentage / 100))
+  {
+    NFD_LOG_INFO("Switching working face of " << state.prefixUri << " from " << mi.currentWorkingFaceId
+                 << " (reward " << currentReward << ") to " << bestFaceId << " (reward " << bestReward << ")");
+    mi.currentWorkingFaceId = bestFaceId;
+    state.stats.recordSwitch();
+  }
+}
+
+FaceId BanditStrategy::selectExplorationArm(PrefixState& state, const Face& inFace,
+                                            const fib::NextHopList& nexthops, const pit::Entry& pitEntry)
+{
+  MeasurementInfo& mi = state.info;
+  double logPulls = std::log(static_cast<double>(state.nPulls + 1));
+
+  FaceId bestFaceId = face::INVALID_FACEID;
+  double bestBound = -1;
+  for (const fib::NextHop& nexthop : nexthops)
+  {
+    FaceId faceId = nexthop.getFace().getId();
+    if (faceId == mi.currentWorkingFaceId || !isUsableArm(nexthop.getFace(), inFace, pitEntry))
+    {
+      continue;
+    }
+    auto pulls = state.pulls.find(faceId);
+    auto faceInfo = mi.faceInfoMap.find(faceId);
+    if (pulls == state.pulls.end() || faceInfo == mi.faceInfoMap.end())
+    {
+      return faceId;
+    }
+    double bound = getReward(faceInfo->second, mi.req) +
+                   EXPLORATION_FACTOR * std::sqrt(logPulls / pulls->second);
+    if (bound > bestBound)
+    {
+      bestBound = bound;
+      bestFaceId = faceId;
+    }
+  }
+  return bestFaceId;
+}
+
+double BanditStrategy::getReward(const InterfaceEstimation& faceInfo, StrategyRequirements& req)
+{
+  double delayLimit = req.getLimit(RequirementType::DELAY);
+  double lossLimit = req.getLimit(RequirementType::LOSS);
+  double delay = faceInfo.getCurrentValue(RequirementType::DELAY);
+  double loss = faceInfo.getCurrentValue(RequirementType::LOSS);
+
+  if (delay > delayLimit || loss > lossLimit ||
+      faceInfo.getCurrentValue(RequirementType::BANDWIDTH) < req.getLimit(RequirementType::BANDWIDTH))
+  {
+    return 0;
+  }
+  double delayReward = std::max(1 - delay / delayLimit, 0.01);
+  double lossReward = (lossLimit > 0) ? std::max(1 - loss / lossLimit, 0.01) : 1;
+  return delayReward * lossReward;
+}
+
+bool BanditStrategy::isUsableArm(const Face& face, const Face& inFace, const pit::Entry& pitEntry)
+{
+  return face.getId() != inFace.getId() && canForwardToLegacy(pitEntry, face);
+}
+
+const PrefixParameters& BanditStrategy::refreshParameters(PrefixState& state)
+{
+  ParameterConfiguration* config = ParameterConfiguration::getInstance();
+  if (state.parameters == nullptr || state.parameters->generation != config->getGeneration())
+  {
+    state.parameters = config->getPrefixParameters(state.prefixUri);
+    state.info.req.setParameter(RequirementType::DELAY, state.parameters->requirementMaxDelay);
+    state.info.req.setParameter(RequirementType::LOSS, state.parameters->requirementMaxLoss);
+    state.info.req.setParameter(RequirementType::BANDWIDTH, state.parameters->requirementMinBandwidth);
+  }
+  return *state.parameters;
+}
+
+BanditStrategy::PrefixState* BanditStrategy::findPrefixState(const pit::Entry& pitEntry)
+{
+  measurements::Entry* me = StrategyHelper::findPrefixMeasurements<PrefixState>(pitEntry, this->getMeasurements());
+  if (me == nullptr)
+  {
+    return nullptr;
+  }
+  PrefixState* state = me->getStrategyInfo<PrefixState>();
+  const PrefixParameters& params = refreshParameters(*state);
+  this->getMeasurements().extendLifetime(*me, time::milliseconds(params.measurementLifetime));
+  return state;
+}
+
+BanditStrategy::PrefixState& BanditStrategy::insertPrefixState(const pit::Entry& pitEntry, const Face& inFace,
+                                                               const fib::NextHopList& nexthops)
+{
+  measurements::Entry* me = StrategyHelper::addPrefixMeasurements(pitEntry.getName(), PREFIX_OFFSET,
+                                                                  this->getMeasurements());
+  PrefixState* state = me->insertStrategyInfo<PrefixState>(me->getName()).first;
+  knownPrefixes.insert(me->getName());
+  if (knownPrefixes.size() >= 2 * std::max<size_t>(nLiveKnownPrefixes, 8))
+  {
+    pruneKnownPrefixes();
+  }
+  const PrefixParameters& params = refreshParameters(*state);
+  this->getMeasurements().extendLifetime(*me, time::milliseconds(params.measurementLifetime));
+
+  // Start on the first usable nexthop, like the best route strategy
+  state->info.currentWorkingFaceId = nexthops[0].getFace().getId();
+  for (const fib::NextHop& nexthop : nexthops)
+  {
+    if (isUsableArm(nexthop.getFace(), inFace, pitEntry))
+    {
+      state->info.currentWorkingFaceId = nexthop.getFace().getId();
+      break;
+    }
+  }
+  NFD_LOG_DEBUG("Created measurements for prefix " << state->prefixUri);
+  return *state;
+}
+
+void BanditStrategy::pruneKnownPrefixes()
+{
+  for (auto it = knownPrefixes.begin(); it != knownPrefixes.end();)
+  {
+    measurements::Entry* me = this->getMeasurements().findExactMatch(*it);
+    if (me == nullptr || me->getStrategyInfo<PrefixState>() == nullptr)
+    {
+      it = knownPrefixes.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  nLiveKnownPrefixes = knownPrefixes.size();
+}
+
+}  // namespace fw
+}  // namespace nfd
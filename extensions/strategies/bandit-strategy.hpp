@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NFD_DAEMON_FW_BANDIT_STRATEGY_HPP
+#define NFD_DAEMON_FW_BANDIT_STRATEGY_HPP
+
+#include "fw/strategy.hpp"
+#include "fw/strategy-helper.hpp"
+#include "fw/../../core/common.hpp"
+#include "fw/../face/face.hpp"
+#include "fw/../table/fib-entry.hpp"
+#include "fw/../table/pit-entry.hpp"
+#include "fw/forwarder.hpp"
+#include "fw/strategy-requirements.hpp"
+#include "fw/interface-estimation.hpp"
+#include "fw/measurement-info.hpp"
+#include "fw/out-record-info.hpp"
+#include "path-selection-stats.hpp"
+#include "../utils/namematcher.h"
+#include "../utils/parameterconfiguration.h"
+#include <set>
+#include <unordered_map>
+
+namespace nfd {
+namespace fw {
+
+/**
+ * @brief Bandit Strategy
+ *
+ * An alternative to the LowestCostStrategy that treats the nexthops of a prefix as the arms of a
+ * multi-armed bandit. The reward of an arm is the headroom its delay and loss estimates leave to the
+ * requirements (0 if a requirement is violated). The working path is the arm with the highest reward.
+ * Tainted probes (limited to one in every MAX_TAINTED_PROBES_PERCENTAGE probes) explore the alternative
+ * with the highest upper confidence bound (UCB1), so paths that are known to be bad are rarely probed
+ * while new or rarely measured paths are probed until their estimates can be trusted.
+ */
+class BanditStrategy : public Strategy, public PathSelectionReporter
+{
+public:
+
+  BanditStrategy(Forwarder& forwarder, const Name& name = STRATEGY_NAME);
+
+  virtual void
+  afterReceiveInterest(const Face& inFace, const Interest& interest, const shared_ptr<pit::Entry>& pitEntry);
+
+  virtual void
+  beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry, const Face& inFace, const Data& data);
+
+  virtual void
+  afterReceiveNack(const Face& inFace, const lp::Nack& nack, const shared_ptr<pit::Entry>& pitEntry);
+
+  virtual void
+  printPathSelectionStats(std::ostream& os, const std::string& label);
+
+public:
+
+  static const Name STRATEGY_NAME;
+
+private:
+
+  /**
+   * The state this strategy keeps for one prefix, stored as strategy info of its measurements entry.
+   */
+  class PrefixState : public StrategyInfo
+  {
+  public:
+    static constexpr int getTypeId()
+    {
+      return 1015;
+    }
+
+    explicit
+    PrefixState(const Name& prefix)
+      : prefix(prefix)
+      , prefixUri(prefix.toUri())
+      , nPulls(0)
+      , probesSinceExploration(0)
+    {
+    }
+
+  public:
+    const Name prefix;
+    const std::string prefixUri;
+
+    // The estimators of all arms and the working face.
+    MeasurementInfo info;
+
+    shared_ptr<const PrefixParameters> parameters;
+
+    PathSelectionStats stats;
+
+    // The number of measured probes sent on each arm, and in total.
+    std::unordered_map<FaceId, uint64_t> pulls;
+    uint64_t nPulls;
+
+    // The number of measured probes since the last tainted one, limiting the share of tainted probes
+    // (the arm they explore is chosen by its upper confidence bound, not by staleness).
+    int probesSinceExploration;
+  };
+
+  /**
+   * Makes the arm with the highest reward the working face. The working face is only left for an arm
+   * whose reward is higher by HYSTERESIS_PERCENTAGE (or if it violates the requirements itself).
+   */
+  void updateWorkingFace(PrefixState& state, const Face& inFace,
+                         const fib::NextHopList& nexthops, const pit::Entry& pitEntry);
+
+  /**
+   * Selects the alternative arm with the highest upper confidence bound. Arms that have never
+   * been pulled are selected first.
+   *
+   * @returns the arm or face::INVALID_FACEID if there is no usable alternative.
+   */
+  FaceId selectExplorationArm(PrefixState& state, const Face& inFace,
+                              const fib::NextHopList& nexthops, const pit::Entry& pitEntry);
+
+  /**
+   * @returns the reward of an arm in [0, 1] (0 if a requirement is violated).
+   */
+  static double getReward(const InterfaceEstimation& faceInfo, StrategyRequirements& req);
+
+  /**
+   * @returns true if the face may be used as an arm for the Interest of the pit entry.
+   */
+  bool isUsableArm(const Face& face, const Face& inFace, const pit::Entry& pitEntry);
+
+  const PrefixParameters& refreshParameters(PrefixState& state);
+
+  PrefixState* findPrefixState(const pit::Entry& pitEntry);
+
+  PrefixState& insertPrefixState(const pit::Entry& pitEntry, const Face& inFace, const fib::NextHopList& nexthops);
+
+  /**
+   * Forgets the prefixes in knownPrefixes whose measurements have expired.
+   */
+  void pruneKnownPrefixes();
+
+  /**
+   * Drops the per-face state (estimators and pulls) of a face
+   * that is being removed. Prefixes that use it as working face pick a new one with their next Interest.
+   */
+  void beforeFaceRemoval(FaceId faceId);
+
+private:
+  // Weight of the confidence bound against the reward.
+  static const double EXPLORATION_FACTOR;
+
+  int PREFIX_OFFSET;
+
+  const NameMatcher probeMatcher;
+
+  // Identity written into the probes tainted by this router, so routers after it can still measure them.
+  const uint64_t tainterId;
+
+  // The prefixes this strategy has created measurements for. Prefixes whose measurements have expired
+  // are forgotten whenever the set has doubled since it was last pruned, and are skipped until then.
+  std::set<Name> knownPrefixes;
+
+  // The number of prefixes in knownPrefixes after it was last pruned.
+  size_t nLiveKnownPrefixes;
+
+  signal::ScopedConnection beforeRemoveFaceConnection;
+};
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif
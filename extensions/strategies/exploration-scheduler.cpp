@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "exploration-scheduler.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace nfd {
+namespace fw {
+
+const uint32_t ExplorationScheduler::MAX_COUNTED_PROBES;
+
+ExplorationScheduler::ExplorationScheduler()
+  : m_budgetCounter(1)
+{
+}
+
+bool ExplorationScheduler::consumeBudget(int probesPerTaintedProbe)
+{
+  if (m_budgetCounter >= probesPerTaintedProbe) {
+    m_budgetCounter = 1;
+    return true;
+  }
+  m_budgetCounter++;
+  return false;
+}
+
+FaceId ExplorationScheduler::selectTarget(const std::vector<Candidate>& candidates, time::steady_clock::TimePoint now) const
+{
+  FaceId bestFaceId = face::INVALID_FACEID;
+  double bestScore = -1;
+  for (const Candidate& candidate : candidates)
+  {
+    auto it = m_faces.find(candidate.faceId);
+    if (it == m_faces.end())
+    {
+      return candidate.faceId;
+    }
+    double staleness = time::duration_cast<time::microseconds>(now - it->second.lastProbe).count();
+    double uncertainty = 1 / std::sqrt(1.0 + std::min(it->second.nProbes, MAX_COUNTED_PROBES));
+    double confidence = std::min(std::max(candidate.confidence, 0.0), 1.0);
+    double score = staleness * uncertainty * (2 - confidence);
+    if (score > bestScore)
+    {
+      bestScore = score;
+      bestFaceId = candidate.faceId;
+    }
+  }
+  return bestFaceId;
+}
+
+void ExplorationScheduler::recordProbe(FaceId faceId, time::steady_clock::TimePoint now)
+{
+  auto it = m_faces.find(faceId);
+  if (it == m_faces.end())
+  {
+    m_faces[faceId] = {now, 1};
+  }
+  else
+  {
+    it->second.lastProbe = now;
+    it->second.nProbes++;
+  }
+}
+
+}  // namespace fw
+}  // namespace nfd
@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NFD_DAEMON_FW_EXPLORATION_SCHEDULER_HPP
+#define NFD_DAEMON_FW_EXPLORATION_SCHEDULER_HPP
+
+#include "fw/../../core/common.hpp"
+#include "fw/../face/face.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace nfd {
+namespace fw {
+
+/**
+ * Decides when a probe of one prefix may be tainted and which alternative face it explores.
+ * Tainted probes are limited to one in every MAX_TAINTED_PROBES_PERCENTAGE probes of the prefix
+ * and go to the face whose estimate is the most stale and uncertain, so all nexthops are measured.
+ */
+class ExplorationScheduler
+{
+public:
+  /**
+   * A face that may be explored, together with the confidence in [0, 1] of its current estimates.
+   */
+  struct Candidate
+  {
+    FaceId faceId;
+    double confidence;
+  };
+
+public:
+  ExplorationScheduler();
+
+  /**
+   * Counts a probe against the exploration budget of the prefix.
+   *
+   * @param probesPerTaintedProbe The value of MAX_TAINTED_PROBES_PERCENTAGE.
+   * @returns true every n-th call, where n is probesPerTaintedProbe.
+   */
+  bool consumeBudget(int probesPerTaintedProbe);
+
+  /**
+   * Selects the face a tainted probe should explore. Faces that have never been explored come first,
+   * otherwise the face with the highest product of staleness (time since it was last explored) and
+   * uncertainty (shrinking with the number of times it has been explored) is selected. Faces that
+   * joined the nexthops later therefore catch up before the exploration settles into a rotation.
+   * A face whose estimates have lost their confidence counts up to twice as urgent.
+   *
+   * @param candidates The faces that may be explored (in nexthop order, which breaks ties).
+   * @returns the selected face or face::INVALID_FACEID if there are no candidates.
+   */
+  FaceId selectTarget(const std::vector<Candidate>& candidates, time::steady_clock::TimePoint now) const;
+
+  /**
+   * Records that a tainted probe has been sent on a face.
+   */
+  void recordProbe(FaceId faceId, time::steady_clock::TimePoint now);
+
+  /**
+   * Forgets everything about a face (e.g. because it was removed).
+   */
+  void removeFace(FaceId faceId)
+  {
+    m_faces.erase(faceId);
+  }
+
+private:
+  struct Exploration
+  {
+    time::steady_clock::TimePoint lastProbe;
+    uint32_t nProbes;
+  };
+
+  // Explorations beyond this number do not make a face any more certain,
+  // so well-known faces are still explored once they have become stale enough.
+  static const uint32_t MAX_COUNTED_PROBES = 16;
+
+private:
+  int m_budgetCounter;
+
+  std::unordered_map<FaceId, Exploration> m_faces;
+};
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif
@@ -0,0 +1,70 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "face-ranking.hpp"
+
+namespace nfd {
+namespace fw {
+
+void FaceRanking::update(FaceId faceId, double headroom)
+{
+  auto it = m_headrooms.find(faceId);
+  if (it == m_headrooms.end())
+  {
+    it = m_headrooms.emplace(faceId, 0).first;
+  }
+  else if (it->second > 0)
+  {
+    m_ranks.erase(Rank(it->second, faceId));
+  }
+
+  it->second = headroom;
+  if (headroom > 0)
+  {
+    m_ranks.insert(Rank(headroom, faceId));
+  }
+}
+
+void FaceRanking::remove(FaceId faceId)
+{
+  auto it = m_headrooms.find(faceId);
+  if (it == m_headrooms.end())
+  {
+    return;
+  }
+  if (it->second > 0)
+  {
+    m_ranks.erase(Rank(it->second, faceId));
+  }
+  m_headrooms.erase(it);
+}
+
+double FaceRanking::getHeadroom(FaceId faceId) const
+{
+  auto it = m_headrooms.find(faceId);
+  return (it == m_headrooms.end() || it->second < 0) ? 0 : it->second;
+}
+
+bool FaceRanking::contains(FaceId faceId) const
+{
+  return m_headrooms.count(faceId) > 0;
+}
+
+}  // namespace fw
+}  // namespace nfd
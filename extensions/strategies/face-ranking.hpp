@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NFD_DAEMON_FW_FACE_RANKING_HPP
+#define NFD_DAEMON_FW_FACE_RANKING_HPP
+
+#include "fw/../face/face.hpp"
+#include <functional>
+#include <set>
+#include <unordered_map>
+#include <utility>
+
+namespace nfd {
+namespace fw {
+
+/**
+ * Keeps the measured faces of one prefix ranked by their headroom (how far they stay within the
+ * requirements). A face is re-ranked whenever one of its estimates changes, so the best face that
+ * meets all requirements is always at the front of the ranking.
+ */
+class FaceRanking
+{
+public:
+  /**
+   * Sets the headroom of a face. A headroom <= 0 marks the face as violating the requirements.
+   */
+  void update(FaceId faceId, double headroom);
+
+  /**
+   * Forgets a face (e.g. because it was removed).
+   */
+  void remove(FaceId faceId);
+
+  /**
+   * @returns the headroom of the face, or 0 if it violates the requirements or was never measured.
+   */
+  double getHeadroom(FaceId faceId) const;
+
+  /**
+   * @returns true if the face has been measured at all.
+   */
+  bool contains(FaceId faceId) const;
+
+  /**
+   * @param isUsable Filters out faces that cannot be used right now (e.g. the current working face).
+   * @returns the usable face with the highest headroom that meets all requirements.
+   * @returns face::INVALID_FACEID if there is no such face.
+   */
+  template<typename Predicate>
+  FaceId getBest(Predicate isUsable) const
+  {
+    for (const auto& rank : m_ranks)
+    {
+      if (isUsable(rank.second))
+      {
+        return rank.second;
+      }
+    }
+    return face::INVALID_FACEID;
+  }
+
+private:
+  typedef std::pair<double, FaceId> Rank;
+
+  // All faces that meet the requirements, highest headroom first.
+  std::set<Rank, std::greater<Rank>> m_ranks;
+
+  // The headroom of every measured face.
+  std::unordered_map<FaceId, double> m_headrooms;
+};
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif
@@ -21,6 +21,9 @@
 #include "core/logger.hpp"
 #include "fw/measurement-info.hpp"
 #include "fw/algorithm.hpp"
+#include <algorithm>
+#include <functional>
+#include <vector>
 #include "../utils/parameterconfiguration.h"
 
 namespace nfd {
@@ -31,14 +34,25 @@ NFD_LOG_INIT("LowestCostStrategy");
 const Name LowestCostStrategy::STRATEGY_NAME("ndn:/localhost/nfd/strategy/lowest-cost/%FD%01/");
 NFD_REGISTER_STRATEGY(LowestCostStrategy);
 
+const double LowestCostStrategy::MIN_CONFIDENCE = 0.5;
+
 LowestCostStrategy::LowestCostStrategy(Forwarder& forwarder, const Name& name)
  :  Strategy(forwarder, name), 
     ownStrategyChoice(forwarder.getStrategyChoice()),
-    taintingCounter(1)
+    ownFib(forwarder.getFib()),
+    PREFIX_OFFSET(ParameterConfiguration::getInstance()->PREFIX_OFFSET),
+    probeMatcher(ParameterConfiguration::getInstance()->PROBE_SUFFIX, PREFIX_OFFSET),
+    nSuppressedSwitches(0),
+    tainterId(StrategyHelper::allocateTainterId()),
+    nLiveKnownPrefixes(0)
 {
-  // Setting shared parameters
-  PROBE_SUFFIX = ParameterConfiguration::getInstance()->PROBE_SUFFIX;
-  PREFIX_OFFSET = ParameterConfiguration::getInstance()->PREFIX_OFFSET;
+  // Follow the state of all faces, so the failure of a working face is noticed right away
+  afterAddFaceConnection = this->afterAddFace.connect([this] (Face& face) { connectFaceState(face); });
+  beforeRemoveFaceConnection = this->beforeRemoveFace.connect([this] (Face& face) { beforeFaceRemoval(face.getId()); });
+  for (Face& face : forwarder.getFaceTable())
+  {
+    connectFaceState(face);
+  }
 }
 
 void LowestCostStrategy::afterReceiveInterest(const Face& inFace, 
@@ -51,77 +65,119 @@ void LowestCostStrategy::afterReceiveInterest(const Face& inFace,
   const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
   const fib::NextHopList& nexthops = fibEntry.getNextHops();
 
-  // Get the current prefix from the interest name
-  std::string currentPrefix = interest.getName().getPrefix(PREFIX_OFFSET).toUri();
+  // Resolve the state of the prefix this Interest belongs to
+  PrefixState* state = findPrefixState(*pitEntry);
 
-  // Set per-prefix parameters
-  refreshParameters(currentPrefix);
-
-  // Check if there are noe measurements yet for the current prefix
-  if (measurementMap.find(currentPrefix) == measurementMap.end())
+  // Check if there are no measurements yet for the current prefix
+  if (state == nullptr)
   {
-    // Create a new MeasurementInfo and place it in the measurementMap under the currentPrefix. 
-    MeasurementInfo mi;
-    mi.req.setParameter(RequirementType::DELAY, REQUIREMENT_MAXDELAY);
-    mi.req.setParameter(RequirementType::LOSS, REQUIREMENT_MAXLOSS);
-    mi.req.setParameter(RequirementType::BANDWIDTH, REQUIREMENT_MINBANDWIDTH);
-    mi.currentWorkingFaceId = getFaceIdViaBestRoute(nexthops, pitEntry);
-    measurementMap[currentPrefix] = mi;
+    state = &insertPrefixState(*pitEntry);
+    state->info.currentWorkingFaceId = getFaceIdViaBestRoute(nexthops, pitEntry);
   }
+  MeasurementInfo& mi = state->info;
+
+  // Get per-prefix parameters
+  const PrefixParameters& params = *state->parameters;
 
   // Get the ID to the outface that this Interest will be forwarded to
-  FaceId selectedOutFaceId = measurementMap[currentPrefix].currentWorkingFaceId;
+  FaceId selectedOutFaceId = mi.currentWorkingFaceId;
+
+  // Probes are measured on the face they are finally sent on (see below)
+  bool isMeasuredProbe = false;
+  bool isOwnProbe = false;
+  bool isExploration = false;
+  uint64_t probeSequence = 0;
 
   // Check if packet is a probe (only probes may be redirected)
-  if (interest.getName().toUri().find(PROBE_SUFFIX) != std::string::npos)
+  if (probeMatcher.matches(interest.getName()))
   {
+    // Judge the working face the probe arrived for, before it is possibly replaced
+    auto workingFaceInfo = mi.faceInfoMap.find(mi.currentWorkingFaceId);
+    if (workingFaceInfo != mi.faceInfoMap.end())
+    {
+      state->stats.checkWorkingFace(workingFaceInfo->second, mi.req, time::steady_clock::now());
+
+      // A link that drops everything sends neither Nacks nor takes the face down, only the probes time out
+      FaceId workingFaceId = mi.currentWorkingFaceId;
+      if (params.failoverProbeTimeouts > 0 &&
+          workingFaceInfo->second.getConsecutiveLosses() >= params.failoverProbeTimeouts)
+      {
+        NFD_LOG_INFO("Face " << workingFaceId << " is unusable for " << state->prefixUri << " ("
+                     << workingFaceInfo->second.getConsecutiveLosses() << " probes timed out in a row)");
+        state->nackedFaces.insert(workingFaceId);
+        updateFaceRanking(*state, workingFaceId);
+        failOver(*state, workingFaceId, pitEntry.get());
+        evacuateFace(*state, workingFaceId);
+      }
+    }
+
     // Determine best outFace (could be another one than currentBestOutFace)
-    measurementMap[currentPrefix].currentWorkingFaceId = lookForBetterOutFaceId(nexthops, pitEntry, currentPrefix);
-    selectedOutFaceId = measurementMap[currentPrefix].currentWorkingFaceId;
+    switchWorkingFace(*state, lookForBetterOutFaceId(nexthops, pitEntry, *state));
+    selectedOutFaceId = mi.currentWorkingFaceId;
 
     // Check if packet is untainted (tainted packets must not be redirected or measured)
     if (!interest.isTainted())
     {
+      // Probe bookkeeping is keyed by the probe's sequence number within this prefix
+      probeSequence = StrategyHelper::getProbeSequence(interest.getName());
+      isMeasuredProbe = true;
+      isOwnProbe = true;
+
       // Check if there is more than one outFace (no need to redirect if no alternatives available)
-      if (nexthops.size() >= MIN_NUM_OF_FACES_FOR_TAINTING)
+      if (nexthops.size() >= params.minNumOfFacesForTainting)
       {
         // Check if this router is allowed to use this probe for monitoring alternative routes 
-        if (taintingAllowed() && TAINTING_ENABLED)
+        FaceId explorationFaceId = face::INVALID_FACEID;
+        if (params.taintingEnabled && state->explorer.consumeBudget(params.maxTaintedProbesPercentage))
+        {
+          explorationFaceId = selectExplorationTarget(*state, inFace, nexthops, *pitEntry);
+        }
+        if (explorationFaceId != face::INVALID_FACEID)
         {
           // Mark Interest as tainted, so other routers don't use it or its data packtes for measurements
           // NOTE: const_cast is a hack and should generally be avoided!
           Interest& nonConstInterest = const_cast<Interest&>(interest);
           nonConstInterest.setTainted(true);
+          nonConstInterest.setTaintedBy(tainterId);
 
           NFD_LOG_INFO("Tainted this interest: " << interest.getName());
 
           // Remember that this probe was tainted by this router, so the corresponding data can be recognized
-          measurementMap[currentPrefix].myTaintedProbes.insert(interest.getName().toUri());
+          mi.myTaintedProbes.insert(probeSequence, time::steady_clock::now(), interest.getInterestLifetime());
 
-          // Prepare an alternative path for the probe 
-          selectedOutFaceId = getAlternativeOutFaceId(measurementMap[currentPrefix].currentWorkingFaceId, nexthops);   
+          // Send the probe on the alternative path that is due for exploration
+          selectedOutFaceId = explorationFaceId;
+          isExploration = true;
+          state->explorer.recordProbe(explorationFaceId, time::steady_clock::now());
 
-          // Send a NACK back to the previous routers so they don't keep measurement data of the tainted Interest 
+          // Send a NACK back to the previous routers so they don't keep measurement data of the tainted Interest.
+          // This also removes the in-record, so the Data of the probe ends here and is not forwarded any further.
           lp::NackHeader nackHeader;
           nackHeader.setReason(lp::NackReason::TAINTED);
           this->sendNack(pitEntry, inFace, nackHeader);
 
           NFD_LOG_INFO("Send NACK for interest: " << interest.getName() << " on face " << inFace.getId() << " with reason " << nackHeader.getReason());
-
-          // Manually re-insert an in-record for the pit entry, so the Interest can still be sent.
-          // NOTE: const_cast is a hack and should generally be avoided!
-          Face& nonConstInFace = const_cast<Face&> (inFace);
-          pitEntry->insertOrUpdateInRecord(nonConstInFace, interest);
         }
       }
-      // Save the probe's sending time in a map for later calculations of rtt. 
-      // This is a workaround since "outRecord->getLastRenewed()" somehow doesn't provide the right value. 
-      measurementMap[currentPrefix].rttTimeMap[interest.getName().toUri()] = time::steady_clock::now(); 
-
-      // Inform the original estimators (by Klaus Schneider) about the probe
-      measurementMap[currentPrefix].faceInfoMap[selectedOutFaceId].addSentInterest(interest.getName().toUri()); 
+    }
+    else if (StrategyHelper::isTaintedBefore(*pitEntry, tainterId))
+    {
+      // This router is after the tainter, so the probe still measures the face it is sent on
+      probeSequence = StrategyHelper::getProbeSequence(interest.getName());
+      isMeasuredProbe = true;
     }
   } 
+  else if (params.multipathEnabled)
+  {
+    // Split the workload over all faces that perform well enough
+    selectedOutFaceId = selectMultipathOutFaceId(*state, interest, *pitEntry);
+  }
+
+  // Remember new push subscriptions, so they can be moved if the working face fails
+  if (interest.isPush() && pitEntry->getOutRecords().empty())
+  {
+    registerPushEntry(*state, pitEntry);
+  }
 
   // Check if chosen face is the face the interest came from
   if (selectedOutFaceId == inFace.getId())
@@ -130,23 +186,40 @@ void LowestCostStrategy::afterReceiveInterest(const Face& inFace,
     selectedOutFaceId = getAlternativeOutFaceId(selectedOutFaceId, nexthops);
   }
 
+  // Inform the original estimators (by Klaus Schneider) about the probe, on the face it is actually sent on
+  if (isOwnProbe)
+  {
+    state->stats.recordProbe(isExploration);
+  }
+  if (isMeasuredProbe)
+  {
+    mi.getOrCreateFaceInfo(selectedOutFaceId, params.bandwidthBuckets, params.bandwidthEwmaGain).addSentInterest(probeSequence);
+    updateFaceRanking(*state, selectedOutFaceId);
+  }
+
   // After everthing else is handled, forward the Interest on the selected face.
   this->sendInterest(pitEntry, getFaceViaId(selectedOutFaceId, nexthops), interest);
 
   NFD_LOG_DEBUG("Sending Interest " << interest.getName() << " on face " << selectedOutFaceId);
 
-  // Printing current measurement status to console. 
-  InterfaceEstimation& faceInfo1 = measurementMap[currentPrefix].faceInfoMap[measurementMap[currentPrefix].currentWorkingFaceId];
+  // Printing current measurement status to console (for the faces that have measurements).
   NFD_LOG_INFO("Interest " << interest.getName() << " forwarded on face " << selectedOutFaceId); 
-  NFD_LOG_INFO("Face (working path): "    << measurementMap[currentPrefix].currentWorkingFaceId 
-                << " - delay: "  << faceInfo1.getCurrentValue(RequirementType::DELAY)  
-                << "ms, loss: " << faceInfo1.getCurrentValue(RequirementType::LOSS) * 100  
-                << "%, bw: "    << faceInfo1.getCurrentValue(RequirementType::BANDWIDTH)); 
-  InterfaceEstimation& faceInfo2 = measurementMap[currentPrefix].faceInfoMap[selectedOutFaceId]; 
-  NFD_LOG_INFO("Face (alternative path): "    << selectedOutFaceId
-                << " - delay: "  << faceInfo2.getCurrentValue(RequirementType::DELAY)  
-                << "ms, loss: " << faceInfo2.getCurrentValue(RequirementType::LOSS) * 100  
-                << "%, bw: "    << faceInfo2.getCurrentValue(RequirementType::BANDWIDTH)); 
+  auto faceInfo1 = mi.faceInfoMap.find(mi.currentWorkingFaceId);
+  if (faceInfo1 != mi.faceInfoMap.end())
+  {
+    NFD_LOG_INFO("Face (working path): "    << mi.currentWorkingFaceId 
+                  << " - delay: "  << faceInfo1->second.getCurrentValue(RequirementType::DELAY)  
+                  << "ms, loss: " << faceInfo1->second.getCurrentValue(RequirementType::LOSS) * 100  
+                  << "%, bw: "    << faceInfo1->second.getCurrentValue(RequirementType::BANDWIDTH)); 
+  }
+  auto faceInfo2 = mi.faceInfoMap.find(selectedOutFaceId); 
+  if (faceInfo2 != mi.faceInfoMap.end())
+  {
+    NFD_LOG_INFO("Face (alternative path): "    << selectedOutFaceId
+                  << " - delay: "  << faceInfo2->second.getCurrentValue(RequirementType::DELAY)  
+                  << "ms, loss: " << faceInfo2->second.getCurrentValue(RequirementType::LOSS) * 100  
+                  << "%, bw: "    << faceInfo2->second.getCurrentValue(RequirementType::BANDWIDTH)); 
+  }
   // std::cout << std::endl;
 
 
@@ -157,65 +230,482 @@ void LowestCostStrategy::afterReceiveInterest(const Face& inFace,
 
 FaceId LowestCostStrategy::lookForBetterOutFaceId(const fib::NextHopList& nexthops,
                                                   const shared_ptr<pit::Entry> pitEntry,
-                                                  std::string currentPrefix)
+                                                  PrefixState& state)
 {
+  MeasurementInfo& mi = state.info;
+  const PrefixParameters& params = *state.parameters;
+
   // Check if there is only one available face anyway.
   if (nexthops.size() <= 2)
   {
     NFD_LOG_INFO("Only one face available. Using bestRoute." << pitEntry->getInterest().getName());
     return getFaceIdViaBestRoute(nexthops, pitEntry);
   }
-  double delayLimit = measurementMap[currentPrefix].req.getLimit(RequirementType::DELAY); 
-  double lossLimit = measurementMap[currentPrefix].req.getLimit(RequirementType::LOSS);
-  double bandwidthLimit = measurementMap[currentPrefix].req.getLimit(RequirementType::BANDWIDTH);
-  double currentDelay = measurementMap[currentPrefix].faceInfoMap[measurementMap[currentPrefix].currentWorkingFaceId].getCurrentValue(RequirementType::DELAY); 
-  double currentLoss = measurementMap[currentPrefix].faceInfoMap[measurementMap[currentPrefix].currentWorkingFaceId].getCurrentValue(RequirementType::LOSS); 
-  double currentBandwidth = measurementMap[currentPrefix].faceInfoMap[measurementMap[currentPrefix].currentWorkingFaceId].getCurrentValue(RequirementType::BANDWIDTH);
+  auto currentFaceInfoIt = mi.faceInfoMap.find(mi.currentWorkingFaceId);
+  if (currentFaceInfoIt == mi.faceInfoMap.end())
+  {
+    NFD_LOG_INFO("No measurements for the current working path yet. Staying on it.");
+    return mi.currentWorkingFaceId;
+  }
+  InterfaceEstimation& currentFaceInfo = currentFaceInfoIt->second;
+  double currentDelay = currentFaceInfo.getCurrentValue(RequirementType::DELAY); 
+  double currentLoss = currentFaceInfo.getCurrentValue(RequirementType::LOSS); 
+  double currentBandwidth = currentFaceInfo.getCurrentValue(RequirementType::BANDWIDTH);
 
   // Check if current working path measurements are still uninitialised
   if (currentDelay == 10 && currentLoss == 0 && currentBandwidth == 0)
   { 
     NFD_LOG_INFO ("Measurements still uninitialised. Staying on current working path.");
-    return measurementMap[currentPrefix].currentWorkingFaceId;
+    return mi.currentWorkingFaceId;
   }
 
-  // Check if current working path underperforms
-  if (currentDelay > delayLimit || currentLoss > lossLimit || currentBandwidth < bandwidthLimit)
+  // Check if current working path underperforms (the exit band lets it exceed the limits a little),
+  // or, in predictive mode, is about to cross the limits within PREDICTIVE_HORIZON
+  const time::milliseconds horizon(params.predictiveHorizon);
+  const time::milliseconds confidenceHalfLife(params.confidenceHalfLife);
+  bool underperforms = !meetsRequirements(currentFaceInfo, mi.req, -params.hysteresisExitPercentage / 100, confidenceHalfLife);
+  if (underperforms || !meetsProjectedRequirements(currentFaceInfo, mi.req, horizon))
   {
-    NFD_LOG_INFO("Current face underperforms: Face " << measurementMap[currentPrefix].currentWorkingFaceId << ", " << currentDelay << ", " << currentLoss * 100 << "%, " << currentBandwidth);
-    // Find potential alternative and get its performance
-    FaceId alternativeOutFaceId = getAlternativeOutFaceId(measurementMap[currentPrefix].currentWorkingFaceId, nexthops);
-    double alternativeDelay = measurementMap[currentPrefix].faceInfoMap[alternativeOutFaceId].getCurrentValue(RequirementType::DELAY); 
-    double alternativeLoss = measurementMap[currentPrefix].faceInfoMap[alternativeOutFaceId].getCurrentValue(RequirementType::LOSS); 
-    double alternativeBandwidth = measurementMap[currentPrefix].faceInfoMap[alternativeOutFaceId].getCurrentValue(RequirementType::BANDWIDTH);
-    
-    // Check if alternative performs well enough
-    if (alternativeDelay <= delayLimit && alternativeLoss <= lossLimit && alternativeBandwidth >= bandwidthLimit)
+    if (underperforms)
     {
-      if (canForwardToLegacy(*pitEntry, getFaceViaId(alternativeOutFaceId, nexthops))) 
-      { 
-        NFD_LOG_INFO("Well performing alternative face found: " << alternativeOutFaceId);
-        return alternativeOutFaceId; 
+      NFD_LOG_INFO("Current face underperforms: Face " << mi.currentWorkingFaceId << ", " << currentDelay << ", " << currentLoss * 100 << "%, " << currentBandwidth);
+    }
+    else
+    {
+      NFD_LOG_INFO("Current face is about to underperform: Face " << mi.currentWorkingFaceId << ", "
+                   << currentFaceInfo.getTrend(RequirementType::DELAY) << " ms/s, "
+                   << currentFaceInfo.getTrend(RequirementType::LOSS) * 100 << "%/s");
+    }
+
+    const time::steady_clock::TimePoint now = time::steady_clock::now();
+    const time::milliseconds halfLife(params.flapPenaltyHalfLife);
+
+    // Stay on a face that has only just been switched to
+    if (state.dampener.isDwelling(now, time::milliseconds(params.minDwellTime)))
+    {
+      suppressSwitch(state, "minimum dwell time not reached");
+      return mi.currentWorkingFaceId;
+    }
+
+    // Re-rank the measured alternatives first, so the decay of stale estimates is reflected in the order
+    for (const fib::NextHop& nexthop : nexthops)
+    {
+      if (state.ranking.contains(nexthop.getFace().getId()))
+      {
+        updateFaceRanking(state, nexthop.getFace().getId());
       }
     }
-    else 
+
+    // Take the best ranked alternative that performs well enough (the enter band asks for a margin)
+    bool penalized = false;
+    FaceId bestOutFaceId = state.ranking.getBest([&] (FaceId faceId) {
+      auto faceInfo = mi.faceInfoMap.find(faceId);
+      if (faceId == mi.currentWorkingFaceId || isDown(faceId) || !isNextHop(faceId, nexthops) ||
+          faceInfo == mi.faceInfoMap.end() ||
+          !canForwardToLegacy(*pitEntry, getFaceViaId(faceId, nexthops)) ||
+          !meetsRequirements(faceInfo->second, mi.req, params.hysteresisPercentage / 100, confidenceHalfLife) ||
+          !meetsProjectedRequirements(faceInfo->second, mi.req, horizon))
+      {
+        return false;
+      }
+      if (state.dampener.getPenalty(faceId, now, halfLife) >= params.flapPenaltyLimit)
+      {
+        penalized = true;
+        return false;
+      }
+      return true;
+    });
+    if (bestOutFaceId != face::INVALID_FACEID)
     {
-      /* 
-       * If alternative also underperforms, take the next alternative and hope for the best 
-       * (since there will be no performance data available yet)
-       */
-      if (canForwardToLegacy(*pitEntry, getFaceViaId(alternativeOutFaceId, nexthops))) 
-      { 
-        NFD_LOG_INFO("Taking next best alternative out of desperation: " << getAlternativeOutFaceId(alternativeOutFaceId, nexthops) << " " << pitEntry->getInterest().getName());
-        return getAlternativeOutFaceId(alternativeOutFaceId, nexthops); 
-      }      
+      NFD_LOG_INFO("Well performing alternative face found: " << bestOutFaceId << " (headroom " << state.ranking.getHeadroom(bestOutFaceId) << ")");
+      return bestOutFaceId;
     }
+    if (penalized)
+    {
+      // Recently flapping faces are only used again once their penalty has decayed
+      suppressSwitch(state, "well performing alternatives flapped recently");
+      return mi.currentWorkingFaceId;
+    }
+
+    // A working path that only threatens to cross the limits is left for measured alternatives only
+    if (!underperforms)
+    {
+      NFD_LOG_INFO("No alternative is expected to perform better. Staying on " << mi.currentWorkingFaceId);
+      return mi.currentWorkingFaceId;
+    }
+
+    /* 
+     * If no measured alternative performs well enough, take an alternative without measurements and
+     * hope for the best. If all alternatives have been measured, just take the next one.
+     */
+    FaceId alternativeOutFaceId = getAlternativeOutFaceId(mi.currentWorkingFaceId, nexthops);
+    for (FaceId faceId = alternativeOutFaceId; faceId != mi.currentWorkingFaceId; faceId = getAlternativeOutFaceId(faceId, nexthops))
+    {
+      if (!state.ranking.contains(faceId) && !isDown(faceId) && canForwardToLegacy(*pitEntry, getFaceViaId(faceId, nexthops)))
+      {
+        alternativeOutFaceId = faceId;
+        break;
+      }
+    }
+    if (state.dampener.getPenalty(alternativeOutFaceId, now, halfLife) >= params.flapPenaltyLimit)
+    {
+      suppressSwitch(state, "alternative flapped recently");
+      return mi.currentWorkingFaceId;
+    }
+    if (canForwardToLegacy(*pitEntry, getFaceViaId(alternativeOutFaceId, nexthops))) 
+    { 
+      NFD_LOG_INFO("Taking next best alternative out of desperation: " << alternativeOutFaceId << " " << pitEntry->getInterest().getName());
+      return alternativeOutFaceId; 
+    }      
   } 
   // If current path performs well enough, just stay on it.
-  NFD_LOG_INFO("Current working path performs well enough. Staying on it. " << measurementMap[currentPrefix].currentWorkingFaceId);
-  return measurementMap[currentPrefix].currentWorkingFaceId;
+  NFD_LOG_INFO("Current working path performs well enough. Staying on it. " << mi.currentWorkingFaceId);
+  return mi.currentWorkingFaceId;
+}
+
+void LowestCostStrategy::switchWorkingFace(PrefixState& state, FaceId newFaceId)
+{
+  if (newFaceId == state.info.currentWorkingFaceId)
+  {
+    return;
+  }
+  NFD_LOG_INFO("Switching working face of " << state.prefixUri << " from " << state.info.currentWorkingFaceId << " to " << newFaceId);
+  FaceId oldFaceId = state.info.currentWorkingFaceId;
+  state.dampener.recordSwitch(oldFaceId, time::steady_clock::now(),
+                              time::milliseconds(state.parameters->flapPenaltyHalfLife));
+  state.info.currentWorkingFaceId = newFaceId;
+  state.stats.recordSwitch();
+
+  // Re-anchor the push subscriptions on the new working face (in multipath mode they stay spread)
+  const fib::NextHopList& nexthops = ownFib.findLongestPrefixMatch(state.prefix).getNextHops();
+  if (!state.parameters->multipathEnabled && !nexthops.empty() && !state.pushEntries.empty())
+  {
+    reexpressPushInterests(state, oldFaceId, getFaceViaId(newFaceId, nexthops));
+  }
+}
+
+void LowestCostStrategy::suppressSwitch(PrefixState& state, const char* reason)
+{
+  state.dampener.recordSuppressedSwitch();
+  ++nSuppressedSwitches;
+  NFD_LOG_INFO("Suppressed switch away from face " << state.info.currentWorkingFaceId << " of " << state.prefixUri << ": " << reason
+               << " (" << state.dampener.getSuppressedSwitches() << " suppressed for this prefix, " << nSuppressedSwitches << " in total)");
+}
+
+void LowestCostStrategy::failOver(PrefixState& state, FaceId failedFaceId, const pit::Entry* pitEntry)
+{
+  const fib::NextHopList& nexthops = ownFib.findLongestPrefixMatch(state.prefix).getNextHops();
+  auto isUsable = [&] (FaceId faceId) {
+    return faceId != failedFaceId && !isDown(faceId) && state.nackedFaces.count(faceId) == 0 &&
+           isNextHop(faceId, nexthops) &&
+           (pitEntry == nullptr || canForwardToLegacy(*pitEntry, getFaceViaId(faceId, nexthops)));
+  };
+
+  // Promote the best ranked face that is still usable
+  FaceId newFaceId = state.ranking.getBest(isUsable);
+
+  // Without measured alternatives, take the first usable nexthop (the failed face may no longer be one)
+  if (newFaceId == face::INVALID_FACEID)
+  {
+    for (const fib::NextHop& nexthop : nexthops)
+    {
+      if (isUsable(nexthop.getFace().getId()))
+      {
+        newFaceId = nexthop.getFace().getId();
+        break;
+      }
+    }
+  }
+  if (newFaceId == face::INVALID_FACEID)
+  {
+    NFD_LOG_WARN("Working face " << failedFaceId << " of " << state.prefixUri << " failed, but there is no alternative.");
+    return;
+  }
+
+  NFD_LOG_INFO("Working face " << failedFaceId << " of " << state.prefixUri << " failed. Failing over to face " << newFaceId);
+  // Also moves the push subscriptions away from the failed face (see evacuateFace() for multipath mode)
+  switchWorkingFace(state, newFaceId);
+  if (!state.failoverPending)
+  {
+    state.failoverPending = true;
+    state.failoverTime = time::steady_clock::now();
+  }
+}
+
+void LowestCostStrategy::evacuateFace(PrefixState& state, FaceId failedFaceId)
+{
+  if (!state.parameters->multipathEnabled || state.pushEntries.empty() ||
+      state.info.currentWorkingFaceId == failedFaceId)
+  {
+    return;
+  }
+  const fib::NextHopList& nexthops = ownFib.findLongestPrefixMatch(state.prefix).getNextHops();
+  if (!nexthops.empty())
+  {
+    reexpressPushInterests(state, failedFaceId, getFaceViaId(state.info.currentWorkingFaceId, nexthops));
+  }
 }
 
+void LowestCostStrategy::reexpressPushInterests(PrefixState& state, FaceId oldFaceId, Face& outFace)
+{
+  prunePushEntries(state);
+
+  int nReexpressed = 0;
+  for (const weak_ptr<pit::Entry>& entry : state.pushEntries)
+  {
+    shared_ptr<pit::Entry> pitEntry = entry.lock();
+    const pit::OutRecordCollection& outRecords = pitEntry->getOutRecords();
+    auto oldOutRecord = std::find_if(outRecords.begin(), outRecords.end(),
+                                     [oldFaceId] (const pit::OutRecord& outRecord) {
+                                       return outRecord.getFace().getId() == oldFaceId;
+                                     });
+    bool isAnchoredOnOldFace = oldOutRecord != outRecords.end() || outRecords.empty();
+    if (!isAnchoredOnOldFace || pitEntry->getOutRecord(outFace) != outRecords.end() || !canForwardToLegacy(*pitEntry, outFace))
+    {
+      continue;
+    }
+
+    Interest interest(pitEntry->getInterest());
+    interest.refreshNonce();
+    this->sendInterest(pitEntry, outFace, interest);
+    nReexpressed++;
+
+    // Let the subscription on the old face lapse upstream
+    if (oldOutRecord != outRecords.end())
+    {
+      pitEntry->deleteOutRecord(oldOutRecord->getFace());
+    }
+  }
+  NFD_LOG_INFO("Re-anchored " << nReexpressed << " push Interests of " << state.prefixUri << " from face " << oldFaceId << " to face " << outFace.getId());
+}
+
+void LowestCostStrategy::registerPushEntry(PrefixState& state, const shared_ptr<pit::Entry>& pitEntry)
+{
+  state.pushEntries.push_back(pitEntry);
+
+  // Forget expired entries whenever the list has doubled, so it stays proportional to the live subscriptions
+  if (state.pushEntries.size() >= 2 * std::max<size_t>(state.nLivePushEntries, 8))
+  {
+    prunePushEntries(state);
+  }
+}
+
+void LowestCostStrategy::prunePushEntries(PrefixState& state)
+{
+  state.pushEntries.erase(std::remove_if(state.pushEntries.begin(), state.pushEntries.end(),
+                                         [] (const weak_ptr<pit::Entry>& entry) {
+                                           shared_ptr<pit::Entry> pitEntry = entry.lock();
+                                           return pitEntry == nullptr || pitEntry->getInRecords().empty();
+                                         }),
+                          state.pushEntries.end());
+  state.nLivePushEntries = state.pushEntries.size();
+}
+
+void LowestCostStrategy::connectFaceState(Face& face)
+{
+  FaceId faceId = face.getId();
+  faceStateConnections[faceId] = face.afterStateChange.connect(
+    [this, faceId] (face::FaceState, face::FaceState newState) {
+      afterFaceStateChange(faceId, newState);
+    });
+}
+
+void LowestCostStrategy::afterFaceStateChange(FaceId faceId, face::FaceState newState)
+{
+  if (newState == face::FaceState::UP)
+  {
+    if (downFaces.erase(faceId) > 0)
+    {
+      NFD_LOG_INFO("Face " << faceId << " is up again.");
+    }
+    return;
+  }
+  if (!downFaces.insert(faceId).second)
+  {
+    return;
+  }
+  NFD_LOG_INFO("Face " << faceId << " went down (" << newState << ").");
+
+  for (auto it = knownPrefixes.begin(); it != knownPrefixes.end();)
+  {
+    measurements::Entry* me = this->getMeasurements().findExactMatch(*it);
+    PrefixState* state = (me == nullptr) ? nullptr : me->getStrategyInfo<PrefixState>();
+    if (state == nullptr)
+    {
+      // The measurements of this prefix have been evicted in the meantime
+      it = knownPrefixes.erase(it);
+      continue;
+    }
+    state->ranking.update(faceId, 0);
+    state->multipathSelector.setWeight(faceId, 0);
+    if (state->info.currentWorkingFaceId == faceId)
+    {
+      failOver(*state, faceId);
+    }
+    evacuateFace(*state, faceId);
+    ++it;
+  }
+}
+
+void LowestCostStrategy::beforeFaceRemoval(FaceId faceId)
+{
+  // Treat the face as down, so failovers do not pick it
+  faceStateConnections.erase(faceId);
+  downFaces.insert(faceId);
+
+  for (auto it = knownPrefixes.begin(); it != knownPrefixes.end();)
+  {
+    measurements::Entry* me = this->getMeasurements().findExactMatch(*it);
+    PrefixState* state = (me == nullptr) ? nullptr : me->getStrategyInfo<PrefixState>();
+    if (state == nullptr)
+    {
+      it = knownPrefixes.erase(it);
+      continue;
+    }
+    if (state->info.currentWorkingFaceId == faceId)
+    {
+      failOver(*state, faceId);
+    }
+    evacuateFace(*state, faceId);
+    state->info.faceInfoMap.erase(faceId);
+    state->ranking.remove(faceId);
+    state->multipathSelector.setWeight(faceId, 0);
+    state->nackedFaces.erase(faceId);
+    state->dampener.removeFace(faceId);
+    state->explorer.removeFace(faceId);
+    ++it;
+  }
+  downFaces.erase(faceId);
+  NFD_LOG_INFO("Face " << faceId << " was removed, its measurements are dropped.");
+}
+
+bool LowestCostStrategy::hasConfidence(const InterfaceEstimation& faceInfo, time::milliseconds confidenceHalfLife)
+{
+  return confidenceHalfLife <= time::milliseconds::zero() || faceInfo.getConfidence(confidenceHalfLife) >= MIN_CONFIDENCE;
+}
+
+double LowestCostStrategy::getEstimate(const InterfaceEstimation& faceInfo, StrategyRequirements& req, RequirementType type,
+                                       time::milliseconds confidenceHalfLife)
+{
+  if (confidenceHalfLife <= time::milliseconds::zero())
+  {
+    return faceInfo.getCurrentValue(type);
+  }
+  return faceInfo.getDecayedValue(type, req.getLimit(type), confidenceHalfLife);
+}
+
+bool LowestCostStrategy::meetsRequirements(const InterfaceEstimation& faceInfo, StrategyRequirements& req, double margin,
+                                           time::milliseconds confidenceHalfLife)
+{
+  return hasConfidence(faceInfo, confidenceHalfLife) &&
+         getEstimate(faceInfo, req, RequirementType::DELAY, confidenceHalfLife) <= req.getLimit(RequirementType::DELAY) * (1 - margin) &&
+         getEstimate(faceInfo, req, RequirementType::LOSS, confidenceHalfLife) <= req.getLimit(RequirementType::LOSS) * (1 - margin) &&
+         getEstimate(faceInfo, req, RequirementType::BANDWIDTH, confidenceHalfLife) >= req.getLimit(RequirementType::BANDWIDTH) * (1 + margin);
+}
+
+bool LowestCostStrategy::meetsProjectedRequirements(const InterfaceEstimation& faceInfo, StrategyRequirements& req,
+                                                    time::milliseconds horizon)
+{
+  if (horizon <= time::milliseconds::zero())
+  {
+    return true;
+  }
+  return faceInfo.getProjectedValue(RequirementType::DELAY, horizon) <= req.getLimit(RequirementType::DELAY) &&
+         faceInfo.getProjectedValue(RequirementType::LOSS, horizon) <= req.getLimit(RequirementType::LOSS);
+}
+
+
+FaceId LowestCostStrategy::selectMultipathOutFaceId(PrefixState& state,
+                                                    const Interest& interest,
+                                                    pit::Entry& pitEntry)
+{
+  // Keep push subscriptions pinned to a single upstream
+  if (interest.isPush())
+  {
+    for (const pit::OutRecord& outRecord : pitEntry.getOutRecords())
+    {
+      if (state.multipathSelector.contains(outRecord.getFace().getId()))
+      {
+        return outRecord.getFace().getId();
+      }
+    }
+  }
+
+  FaceId faceId = state.multipathSelector.select();
+  if (faceId == face::INVALID_FACEID)
+  {
+    NFD_LOG_DEBUG("No face of " << state.prefixUri << " performs well enough for multipath. Using working path.");
+    faceId = state.info.currentWorkingFaceId;
+  }
+
+  // A push subscription whose upstream has left the rotation moves to the new face. Let the subscription
+  // on the old face lapse (as reexpressPushInterests() does), since push Data is accepted from any out-record.
+  if (interest.isPush())
+  {
+    std::vector<std::reference_wrapper<Face>> staleFaces;
+    for (const pit::OutRecord& outRecord : pitEntry.getOutRecords())
+    {
+      if (outRecord.getFace().getId() != faceId)
+      {
+        staleFaces.push_back(outRecord.getFace());
+      }
+    }
+    for (Face& staleFace : staleFaces)
+    {
+      pitEntry.deleteOutRecord(staleFace);
+    }
+  }
+  return faceId;
+}
+
+void LowestCostStrategy::updateFaceRanking(PrefixState& state, FaceId faceId)
+{
+  auto faceInfo = state.info.faceInfoMap.find(faceId);
+  if (faceInfo == state.info.faceInfoMap.end())
+  {
+    state.ranking.remove(faceId);
+    state.multipathSelector.setWeight(faceId, 0);
+    return;
+  }
+  // A face that is down or has Nacked keeps no headroom until it is up and has delivered probe Data again
+  double headroom = 0;
+  if (!isDown(faceId) && state.nackedFaces.count(faceId) == 0)
+  {
+    headroom = getHeadroom(faceInfo->second, state.info.req,
+                           time::milliseconds(state.parameters->confidenceHalfLife));
+  }
+  state.ranking.update(faceId, headroom);
+  if (state.parameters->multipathEnabled)
+  {
+    state.multipathSelector.setWeight(faceId, headroom);
+  }
+  NFD_LOG_DEBUG("Headroom of face " << faceId << " for " << state.prefixUri << ": " << headroom);
+}
+
+double LowestCostStrategy::getHeadroom(const InterfaceEstimation& faceInfo, StrategyRequirements& req,
+                                       time::milliseconds confidenceHalfLife)
+{
+  double delayLimit = req.getLimit(RequirementType::DELAY);
+  double lossLimit = req.getLimit(RequirementType::LOSS);
+  double bandwidthLimit = req.getLimit(RequirementType::BANDWIDTH);
+  if (!hasConfidence(faceInfo, confidenceHalfLife))
+  {
+    return 0;
+  }
+  double delay = getEstimate(faceInfo, req, RequirementType::DELAY, confidenceHalfLife);
+  double loss = getEstimate(faceInfo, req, RequirementType::LOSS, confidenceHalfLife);
+  double bandwidth = getEstimate(faceInfo, req, RequirementType::BANDWIDTH, confidenceHalfLife);
+
+  if (delay > delayLimit || loss > lossLimit || bandwidth < bandwidthLimit)
+  {
+    return 0;
+  }
+
+  // Share of the delay and loss budgets that is still unused (a face right at a limit keeps a small share)
+  double delayHeadroom = std::max(1 - delay / delayLimit, 0.01);
+  double lossHeadroom = (lossLimit > 0) ? std::max(1 - loss / lossLimit, 0.01) : 1;
+  return delayHeadroom * lossHeadroom;
+}
 
 FaceId LowestCostStrategy::getFaceIdViaBestRoute( const fib::NextHopList& nexthops, 
                                                   const shared_ptr<pit::Entry> pitEntry)
@@ -251,6 +741,18 @@ FaceId LowestCostStrategy::getAlternativeOutFaceId( FaceId outFaceId,
   return outFaceId;
 }
 
+bool LowestCostStrategy::isNextHop(FaceId faceId, const fib::NextHopList& nexthops)
+{
+  for (const fib::NextHop& nexthop : nexthops)
+  {
+    if (nexthop.getFace().getId() == faceId)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 Face& LowestCostStrategy::getFaceViaId( FaceId faceId, 
                                         const fib::NextHopList& nexthops)
 {
@@ -266,29 +768,88 @@ Face& LowestCostStrategy::getFaceViaId( FaceId faceId,
   return nexthops[0].getFace();
 }
 
-bool LowestCostStrategy::taintingAllowed()
+LowestCostStrategy::PrefixState* LowestCostStrategy::findPrefixState(const pit::Entry& pitEntry)
 {
-  if (taintingCounter >= MAX_TAINTED_PROBES_PERCENTAGE) {
-    taintingCounter = 1;
-    return true;
+  measurements::Entry* me = StrategyHelper::findPrefixMeasurements<PrefixState>(pitEntry, this->getMeasurements());
+  if (me == nullptr)
+  {
+    return nullptr;
   }
-  else {
-    taintingCounter++;
-    return false;
+  PrefixState* state = me->getStrategyInfo<PrefixState>();
+  extendPrefixLifetime(*me, refreshParameters(*state));
+  return state;
+}
+
+LowestCostStrategy::PrefixState& LowestCostStrategy::insertPrefixState(const pit::Entry& pitEntry)
+{
+  measurements::Entry* me = StrategyHelper::addPrefixMeasurements(pitEntry.getName(), PREFIX_OFFSET,
+                                                                  this->getMeasurements());
+  PrefixState* state = me->insertStrategyInfo<PrefixState>(me->getName()).first;
+  knownPrefixes.insert(me->getName());
+  if (knownPrefixes.size() >= 2 * std::max<size_t>(nLiveKnownPrefixes, 8))
+  {
+    pruneKnownPrefixes();
   }
+  extendPrefixLifetime(*me, refreshParameters(*state));
+  NFD_LOG_DEBUG("Created measurements for prefix " << state->prefixUri);
+  return *state;
 }
 
-void LowestCostStrategy::refreshParameters(std::string currentPrefix) 
+void LowestCostStrategy::pruneKnownPrefixes()
 {
-  //Setting parametes with values from ParameterConfiguration;
-  TAINTING_ENABLED = ParameterConfiguration::getInstance()->getParameter("TAINTING_ENABLED", currentPrefix);
-  MIN_NUM_OF_FACES_FOR_TAINTING = ParameterConfiguration::getInstance()->getParameter("MIN_NUM_OF_FACES_FOR_TAINTING", currentPrefix);
-  MAX_TAINTED_PROBES_PERCENTAGE = ParameterConfiguration::getInstance()->getParameter("MAX_TAINTED_PROBES_PERCENTAGE", currentPrefix);
-  REQUIREMENT_MAXDELAY = ParameterConfiguration::getInstance()->getParameter("REQUIREMENT_MAXDELAY", currentPrefix);
-  REQUIREMENT_MAXLOSS = ParameterConfiguration::getInstance()->getParameter("REQUIREMENT_MAXLOSS", currentPrefix);
-  REQUIREMENT_MINBANDWIDTH = ParameterConfiguration::getInstance()->getParameter("REQUIREMENT_MINBANDWIDTH", currentPrefix);
-  HYSTERESIS_PERCENTAGE = ParameterConfiguration::getInstance()->getParameter("HYSTERESIS_PERCENTAGE", currentPrefix);
-  RTT_TIME_TABLE_MAX_DURATION = time::milliseconds((int)ParameterConfiguration::getInstance()->getParameter("RTT_TIME_TABLE_MAX_DURATION", currentPrefix));
+  for (auto it = knownPrefixes.begin(); it != knownPrefixes.end();)
+  {
+    measurements::Entry* me = this->getMeasurements().findExactMatch(*it);
+    if (me == nullptr || me->getStrategyInfo<PrefixState>() == nullptr)
+    {
+      it = knownPrefixes.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  nLiveKnownPrefixes = knownPrefixes.size();
+}
+
+void LowestCostStrategy::extendPrefixLifetime(measurements::Entry& entry, const PrefixParameters& params)
+{
+  this->getMeasurements().extendLifetime(entry, time::milliseconds(params.measurementLifetime));
+}
+
+FaceId LowestCostStrategy::selectExplorationTarget(PrefixState& state, const Face& inFace,
+                                                   const fib::NextHopList& nexthops, const pit::Entry& pitEntry)
+{
+  const time::milliseconds confidenceHalfLife(state.parameters->confidenceHalfLife);
+  std::vector<ExplorationScheduler::Candidate> candidates;
+  for (const fib::NextHop& nexthop : nexthops)
+  {
+    FaceId faceId = nexthop.getFace().getId();
+    if (faceId != state.info.currentWorkingFaceId && faceId != inFace.getId() && !isDown(faceId) &&
+        canForwardToLegacy(pitEntry, nexthop.getFace()))
+    {
+      auto faceInfo = state.info.faceInfoMap.find(faceId);
+      double confidence = (faceInfo != state.info.faceInfoMap.end()) ? faceInfo->second.getConfidence(confidenceHalfLife) : 0;
+      candidates.push_back({faceId, confidence});
+    }
+  }
+  return state.explorer.selectTarget(candidates, time::steady_clock::now());
+}
+
+const PrefixParameters& LowestCostStrategy::refreshParameters(PrefixState& state)
+{
+  ParameterConfiguration* config = ParameterConfiguration::getInstance();
+
+  // Only fetch a new snapshot if the configuration has changed since the last one
+  if (state.parameters == nullptr || state.parameters->generation != config->getGeneration())
+  {
+    state.parameters = config->getPrefixParameters(state.prefixUri);
+    state.info.req.setParameter(RequirementType::DELAY, state.parameters->requirementMaxDelay);
+    state.info.req.setParameter(RequirementType::LOSS, state.parameters->requirementMaxLoss);
+    state.info.req.setParameter(RequirementType::BANDWIDTH, state.parameters->requirementMinBandwidth);
+    NFD_LOG_DEBUG("Refreshed parameters of " << state.prefixUri << " (generation " << state.parameters->generation << ")");
+  }
+  return *state.parameters;
 }
 
 
@@ -298,60 +859,84 @@ void LowestCostStrategy::beforeSatisfyInterest( const shared_ptr<pit::Entry>& pi
 {
   NFD_LOG_DEBUG("Received data: " << data.getName());
 
-  // Get the current prefix from the data name
-  std::string currentPrefix = data.getName().getPrefix(PREFIX_OFFSET).toUri();
+  // Resolve the state of the prefix this Data belongs to
+  PrefixState* state = findPrefixState(*pitEntry);
+  if (state == nullptr)
+  {
+    NFD_LOG_DEBUG("No measurements for the prefix of " << data.getName());
+    return;
+  }
+  MeasurementInfo& mi = state->info;
+
+  // Get per-prefix parameters
+  const PrefixParameters& params = *state->parameters;
 
-  // Set per-prefix parameters
-  refreshParameters(currentPrefix);
+  // Report how long it took until Data arrived on the new working face after a failover
+  if (state->failoverPending && inFace.getId() == mi.currentWorkingFaceId)
+  {
+    state->failoverPending = false;
+    time::steady_clock::Duration recoveryTime = time::steady_clock::now() - state->failoverTime;
+    state->stats.recordRecovery(recoveryTime);
+    NFD_LOG_INFO("Recovered " << state->prefixUri << " on face " << inFace.getId() << " after "
+                 << time::duration_cast<time::milliseconds>(recoveryTime).count() << " ms");
+  }
 
   // Check if incoming data is probe data
-  if (data.getName().toUri().find(PROBE_SUFFIX) != std::string::npos)
+  if (probeMatcher.matches(data.getName()))
   {
-    // Check if it's an answer to one of the probes tainted by this router
-    auto myTaintedProbesIterator = measurementMap[currentPrefix].myTaintedProbes.find(data.getName().toUri());
-    bool taintedByThisRouter = (myTaintedProbesIterator != measurementMap[currentPrefix].myTaintedProbes.end()) ? true : false;
+    const uint64_t probeSequence = StrategyHelper::getProbeSequence(data.getName());
 
-    // Check if usable for measurement (tainted by this router or not tainted at all)
-    if (taintedByThisRouter || !data.isTainted())
+    // Check if it's an answer to one of the probes tainted by this router (and forget about it, since it is satisfied now)
+    bool taintedByThisRouter = mi.myTaintedProbes.erase(probeSequence, time::steady_clock::now());
+
+    // Check if usable for measurement (tainted by this router, by a router before this one or not tainted at all)
+    if (taintedByThisRouter || !data.isTainted() || StrategyHelper::isTaintedBefore(*pitEntry, tainterId))
     {
       if (taintedByThisRouter)
       {
-        // Forget about the corresponding tainted probe (since it is satisfied now)
-        measurementMap[currentPrefix].myTaintedProbes.erase(myTaintedProbesIterator);
-        NFD_LOG_INFO("Removed " << data.getName() << "from myTaintedProbes.");
-
-        // @todo: Find a way to stop the data packet from being forwarded any further.
+        // The Data is absorbed here, since the TAINTED Nack has already removed the in-record of the previous router
+        state->stats.recordAbsorbedProbe(data.wireEncode().size());
+        NFD_LOG_INFO("Absorbed " << data.getName() << " and removed it from myTaintedProbes.");
       }
-      // Inform loss estimator
-      InterfaceEstimation& faceInfo = measurementMap[currentPrefix].faceInfoMap[inFace.getId()];
-      faceInfo.addSatisfiedInterest(data.getContent().value_size(), data.getName().toUri());
+      // Inform loss estimator (a face without estimators has never been sent a probe, or has been removed since)
+      auto faceInfoIt = mi.faceInfoMap.find(inFace.getId());
+      if (faceInfoIt == mi.faceInfoMap.end())
+      {
+        return;
+      }
+      InterfaceEstimation& faceInfo = faceInfoIt->second;
+      faceInfo.addSatisfiedInterest(data.getContent().value_size(), probeSequence);
+      state->nackedFaces.erase(inFace.getId());
       pit::OutRecordCollection::const_iterator outRecord = pitEntry->getOutRecord(inFace);
 
-      // Check if not already satisfied by another upstream
-      if (!pitEntry->getInRecords().empty() && outRecord != pitEntry->getOutRecords().end()) 
+      // Check if not already satisfied by another upstream (the pit entry of an own tainted probe has no in-records)
+      if ((taintedByThisRouter || !pitEntry->getInRecords().empty()) && outRecord != pitEntry->getOutRecords().end()) 
       {
-        // There is an in and outrecord --> inform RTT estimator
-        time::steady_clock::Duration rtt = time::steady_clock::now() - measurementMap[currentPrefix].rttTimeMap[data.getName().toUri()];
-        faceInfo.addRttMeasurement(time::duration_cast < time::microseconds > (rtt));
-        measurementMap[currentPrefix].rttTimeMap.erase(data.getName().toUri()); 
-
-        // Delete every entry in rttTimeMap that is older than a certain threshold.
-        for ( auto it = measurementMap[currentPrefix].rttTimeMap.begin(); it != measurementMap[currentPrefix].rttTimeMap.end();) 
+        // There is an in and outrecord --> inform RTT estimator with the send time the forwarder
+        // stamped on the out-record of this face (samples above RTT_TIME_TABLE_MAX_DURATION are ignored)
+        const OutRecordInfo* outRecordInfo = outRecord->getStrategyInfo<OutRecordInfo>();
+        if (outRecordInfo != nullptr)
         {
-          (time::steady_clock::now()-it->second > RTT_TIME_TABLE_MAX_DURATION) ? it=measurementMap[currentPrefix].rttTimeMap.erase(it) : it++ ;
-        } 
+          time::steady_clock::Duration rtt = time::steady_clock::now() - outRecordInfo->sendTime;
+          if (rtt <= time::milliseconds(params.rttTimeTableMaxDuration))
+          {
+            faceInfo.addRttMeasurement(time::duration_cast < time::microseconds > (rtt));
+          }
+        }
       }   
+      updateFaceRanking(*state, inFace.getId());
     }    
-    else 
-    {
-      /*
-      * @todo: Find a way to determine if this router is before or after the "tainter", since it could theoretically 
-      *        use tainted probes for measurement as long as it is a router after the tainter.
-      */
-    }
-
 
   } 
+  else if (data.isPush())
+  {
+    // Push data measures the bandwidth of its face passively
+    auto faceInfo = mi.faceInfoMap.find(inFace.getId());
+    if (faceInfo != mi.faceInfoMap.end())
+    {
+      faceInfo->second.addPassiveData(data.getContent().value_size());
+    }
+  }
 }
 
 void 
@@ -361,25 +946,81 @@ LowestCostStrategy::afterReceiveNack( const Face& inFace,
 {
   NFD_LOG_DEBUG("Received NACK for " << pitEntry->getInterest().getName() << " with NackReason = " << nack.getReason());
 
-  // Get the current prefix from the pit entry
-  std::string currentPrefix = pitEntry->getInterest().getName().getPrefix(PREFIX_OFFSET).toUri();
-
-  // Set per-prefix parameters
-  refreshParameters(currentPrefix);
+  // Resolve the state of the prefix the pit entry belongs to
+  PrefixState* state = findPrefixState(*pitEntry);
+  if (state == nullptr)
+  {
+    NFD_LOG_DEBUG("No measurements for the prefix of " << pitEntry->getInterest().getName());
+    return;
+  }
+  MeasurementInfo& mi = state->info;
 
   if (nack.getReason() == lp::NackReason::TAINTED)
   {
       /*
        * Cancel measurements for tainted data packet (so that measurements are not skewed by 'missing packtets'). 
-       * Delay: Just dont calculate rtt, entries will drop out of the custom list on their own
+       * Delay: Just dont calculate rtt, the send time is kept in the out-record and goes away with it
        * Loss: Omit "addSatisfiedInterest" and remove the corresponding entry from the estimator
        * Bandwith: Omit "addSatisfiedInterest"
        */ 
-      measurementMap[currentPrefix].faceInfoMap[inFace.getId()].removeSentInterest(pitEntry->getInterest().getName().toUri());
+      auto faceInfo = mi.faceInfoMap.find(inFace.getId());
+      if (faceInfo != mi.faceInfoMap.end())
+      {
+        faceInfo->second.removeSentInterest(StrategyHelper::getProbeSequence(pitEntry->getInterest().getName()));
+      }
       NFD_LOG_INFO("Removed measurements for " << pitEntry->getInterest().getName());
 
-      // Forward NACK further back to the previous routers so they don't keep measurement data of the tainted Interest either.
-      this->sendNack(pitEntry, pitEntry->getInRecords().begin()->getFace(), nack.getHeader());
+      // Forward NACK further back to the previous routers so they don't keep measurement data of the tainted Interest either
+      // (the entry of a probe tainted by this router has no in-record left, since its own Nack removed it)
+      if (!pitEntry->getInRecords().empty())
+      {
+        this->sendNack(pitEntry, pitEntry->getInRecords().begin()->getFace(), nack.getHeader());
+      }
+  }
+  else if (nack.getReason() == lp::NackReason::NO_ROUTE || nack.getReason() == lp::NackReason::CONGESTION)
+  {
+    // The upstream cannot deliver right now, so stop using it for this prefix until it is measured again
+    NFD_LOG_INFO("Face " << inFace.getId() << " is unusable for " << state->prefixUri << " (" << nack.getReason() << ")");
+    state->nackedFaces.insert(inFace.getId());
+    updateFaceRanking(*state, inFace.getId());
+    if (inFace.getId() == mi.currentWorkingFaceId)
+    {
+      failOver(*state, inFace.getId(), pitEntry.get());
+    }
+    evacuateFace(*state, inFace.getId());
+
+    // Retry a nacked pull Interest on the working face (push Interests have been re-expressed by failOver() or evacuateFace()),
+    // but only if the working face is still a nexthop (so the list is not empty) and has not been tried for this entry yet
+    const Interest& interest = pitEntry->getInterest();
+    const fib::NextHopList& nexthops = this->lookupFib(*pitEntry).getNextHops();
+    if (!interest.isPush() && !probeMatcher.matches(interest.getName()) && mi.currentWorkingFaceId != inFace.getId() &&
+        isNextHop(mi.currentWorkingFaceId, nexthops))
+    {
+      Face& outFace = getFaceViaId(mi.currentWorkingFaceId, nexthops);
+      if (pitEntry->getOutRecord(outFace) == pitEntry->getOutRecords().end() && canForwardToLegacy(*pitEntry, outFace))
+      {
+        Interest retry(interest);
+        retry.refreshNonce();
+        this->sendInterest(pitEntry, outFace, retry);
+      }
+    }
+  }
+}
+
+void LowestCostStrategy::printPathSelectionStats(std::ostream& os, const std::string& label)
+{
+  for (const Name& prefix : knownPrefixes)
+  {
+    measurements::Entry* me = this->getMeasurements().findExactMatch(prefix);
+    PrefixState* state = (me == nullptr) ? nullptr : me->getStrategyInfo<PrefixState>();
+    if (state != nullptr)
+    {
+      os << label << " strategy=lowest-cost prefix=" << state->prefixUri << " ";
+      state->stats.print(os, time::steady_clock::now());
+      os << " suppressedSwitches=" << state->dampener.getSuppressedSwitches()
+         << " taintedProbeSetBytes=" << state->info.myTaintedProbes.getMemoryUsage()
+         << " taintedProbeEvictions=" << state->info.myTaintedProbes.getEvictions() << std::endl;
+    }
   }
 }
 
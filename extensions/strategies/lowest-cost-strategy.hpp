@@ -28,8 +28,17 @@
 #include "fw/../table/pit-entry.hpp"
 #include "fw/../table/strategy-choice.hpp"
 #include "fw/forwarder.hpp"
+#include "fw/../table/fib.hpp"
 #include "fw/strategy-requirements.hpp"
 #include "fw/interface-estimation.hpp"
+#include "fw/out-record-info.hpp"
+#include "exploration-scheduler.hpp"
+#include "face-ranking.hpp"
+#include "path-selection-stats.hpp"
+#include "switch-dampener.hpp"
+#include "weighted-face-selector.hpp"
+#include "../utils/namematcher.h"
+#include "../utils/parameterconfiguration.h"
 
 namespace nfd {
 namespace fw {
@@ -37,16 +46,20 @@ namespace fw {
 /** 
  * @brief Lowest Cost Strategy
  *
- * This strategy uses probing to assess the quality of the current working path and one alternative path.
- * If the quality of the working path crosses a threshold (maxldelay, maxloss and minbandwith) all future 
- * interests are sent on the alternative path. The alternative then becomes the working path and a new 
- * alternative is searched for. 
- * Alternative paths are found by using the algorithm from the bestroute_1 strategy (taking the first valid 
- * entry in nexthops). In the case that neither working path nor alternative meet the requirements, the 
- * next best face (other than those two) is selected.
+ * This strategy uses probing to assess the quality of the current working path and its alternative paths.
+ * A share of the probes of each prefix is tainted and sent on the alternative whose measurements are the
+ * most stale and uncertain, so every nexthop is measured. The measured faces are ranked by how far they stay
+ * within the requirements (maxdelay, maxloss and minbandwidth).
  *
+ * If the working path crosses the requirements (or, in predictive mode, is about to), all future Interests are
+ * sent on the best ranked alternative that meets them, subject to hysteresis, a minimum dwell time and flap
+ * dampening. If no alternative meets them, a face that has not been measured yet or the next nexthop is tried.
+ * A working path that goes down, Nacks or lets probes time out in a row is failed over to right away.
+ *
+ * In multipath mode, the workload is split over all faces that meet the requirements by their headroom,
+ * while push subscriptions stay pinned to a single upstream.
  */
-class LowestCostStrategy : public Strategy
+class LowestCostStrategy : public Strategy, public PathSelectionReporter
 {
 public:
 
@@ -64,10 +77,89 @@ public:
 
 public:
 
+  /**
+   * @returns the number of working path switches that were suppressed by the flap dampening
+   *          (MIN_DWELL_TIME and flap penalties), summed over all prefixes.
+   */
+  uint64_t getSuppressedSwitches() const
+  {
+    return nSuppressedSwitches;
+  }
+
+  virtual void
+  printPathSelectionStats(std::ostream& os, const std::string& label);
+
   static const Name STRATEGY_NAME;
 
 private:
 
+  /**
+   * The state this strategy keeps for one prefix. It is stored as strategy info of the measurements
+   * entry of the prefix, so it is dropped together with the entry once the prefix has been idle for
+   * MEASUREMENT_LIFETIME.
+   */
+  class PrefixState : public StrategyInfo
+  {
+  public:
+    static constexpr int getTypeId()
+    {
+      return 1014;
+    }
+
+    explicit
+    PrefixState(const Name& prefix)
+      : prefix(prefix)
+      , prefixUri(prefix.toUri())
+      , dampener(time::steady_clock::now())
+      , nLivePushEntries(0)
+      , failoverPending(false)
+    {
+    }
+
+  public:
+    // The prefix (name of the measurements entry) this state belongs to.
+    const Name prefix;
+
+    // The URI of the prefix, which is only built once when the state is created.
+    const std::string prefixUri;
+
+    // The measurements for this prefix.
+    MeasurementInfo info;
+
+    // The parameters for this prefix, re-read only if ParameterConfiguration has changed since.
+    shared_ptr<const PrefixParameters> parameters;
+
+    // The measured faces of this prefix, ranked by their headroom.
+    FaceRanking ranking;
+
+    // Splits the workload over the well-performing faces (only used if MULTIPATH_ENABLED is set).
+    WeightedFaceSelector multipathSelector;
+
+    // The faces that sent a NO_ROUTE or CONGESTION Nack, or let FAILOVER_PROBE_TIMEOUTS probes in a row
+    // time out, and have not delivered probe Data since.
+    std::set<FaceId> nackedFaces;
+
+    // Dampens flapping between working faces.
+    SwitchDampener dampener;
+
+    // Decides which probes are tainted and which alternative face they explore.
+    ExplorationScheduler explorer;
+
+    // Probe overhead, switches and requirement violations of this prefix.
+    PathSelectionStats stats;
+
+    // The push PIT entries of this prefix, re-expressed on the new working face after a failover.
+    std::vector<weak_ptr<pit::Entry>> pushEntries;
+
+    // The number of live entries in pushEntries after they were last pruned.
+    size_t nLivePushEntries;
+
+    // Set when the working face failed and no Data has arrived on the new working face yet.
+    bool failoverPending;
+    time::steady_clock::TimePoint failoverTime;
+  };
+
+
   /**
    * Finds an alternative path for probing by selecting the next entry in the FIB
    * in regards to the current working face.
@@ -80,16 +172,158 @@ private:
 
   /**
    * If the current path performs well according to the requirements (maxdelay, maxloss, minbandwith)
-   * this method will just return the current path. If it underperforms,this method will try to provide 
-   * an alternative path that does meet the requirements. If no such path is found, it will return an
+   * this method will just return the current path. If it underperforms,this method will return the
+   * best ranked path that does meet the requirements. If no such path is found, it will return an
    * untested alternative since there is at least the chance it will perform well enough.
    *
    * @param nexthops The list of nexthops in which to search for the face.
    * @param pitEntry The pitEntry of the interest the face is intended for.
-   * @param currentPrefix The Prefix of the interest which needs an outface for forwarding.
+   * @param state The state of the prefix of the interest which needs an outface for forwarding.
    * @returns FaceId of face that should be used for forwarding.
    */
-  FaceId lookForBetterOutFaceId(const fib::NextHopList& nexthops, const shared_ptr<pit::Entry> pitEntry, std::string currentPrefix);
+  FaceId lookForBetterOutFaceId(const fib::NextHopList& nexthops, const shared_ptr<pit::Entry> pitEntry, PrefixState& state);
+
+  /**
+   * Makes a face the working face of a prefix and records the switch for the flap dampening.
+   * The push subscriptions anchored on the old working face are moved to the new one right away,
+   * instead of waiting for the consumers' next refresh. In multipath mode, the subscriptions stay
+   * spread over the faces they were established on.
+   */
+  void switchWorkingFace(PrefixState& state, FaceId newFaceId);
+
+  /**
+   * Counts and logs a working path switch that was suppressed by the flap dampening.
+   */
+  void suppressSwitch(PrefixState& state, const char* reason);
+
+  /**
+   * Moves a prefix off a working face that has failed (face down, NO_ROUTE/CONGESTION Nack or
+   * FAILOVER_PROBE_TIMEOUTS probes in a row timed out, as on a link that drops everything):
+   * promotes the best ranked alternative right away and re-expresses the push Interests of the
+   * prefix on it. Unlike a regular switch, this is not subject to MIN_DWELL_TIME. Faces that are
+   * down, Nacked or no nexthop of the prefix are never picked.
+   *
+   * @param state The state of the prefix whose working face has failed.
+   * @param failedFaceId The face that has failed.
+   * @param pitEntry The PIT entry that revealed the failure, if any. Faces it cannot be forwarded to
+   *                 (see canForwardToLegacy()) are not picked.
+   */
+  void failOver(PrefixState& state, FaceId failedFaceId, const pit::Entry* pitEntry = nullptr);
+
+  /**
+   * In multipath mode, moves the push subscriptions of a prefix that are anchored on a failed face
+   * (down, removed or Nacked) to the working face. Does nothing otherwise, since switchWorkingFace()
+   * has already moved all subscriptions.
+   */
+  void evacuateFace(PrefixState& state, FaceId failedFaceId);
+
+  /**
+   * Moves the live push Interests of a prefix that are anchored on oldFaceId (or on no face at all)
+   * to outFace: they are sent on outFace with a fresh nonce and their out-record on oldFaceId is deleted,
+   * so the forwarder stops accepting push Data from the old face and the upstream subscription lapses.
+   * Push PIT entries that have expired in the meantime are forgotten.
+   */
+  void reexpressPushInterests(PrefixState& state, FaceId oldFaceId, Face& outFace);
+
+  /**
+   * Remembers a push PIT entry, so it can be re-expressed if the working face fails.
+   */
+  void registerPushEntry(PrefixState& state, const shared_ptr<pit::Entry>& pitEntry);
+
+  /**
+   * Forgets push PIT entries that have expired or lost their downstreams.
+   */
+  void prunePushEntries(PrefixState& state);
+
+  /**
+   * Starts following the state of a face, so a face that goes down triggers a failover.
+   */
+  void connectFaceState(Face& face);
+
+  /**
+   * Marks a face as unusable when it goes down (or usable again when it comes back up) and fails over
+   * all prefixes that use it as working face.
+   */
+  void afterFaceStateChange(FaceId faceId, face::FaceState newState);
+
+  /**
+   * Fails over all prefixes that still use a face that is being removed and drops the per-face state
+   * (estimators, ranking, weights, flap penalties and exploration history) of it.
+   */
+  void beforeFaceRemoval(FaceId faceId);
+
+  /**
+   * @returns true if the face is currently down.
+   */
+  bool isDown(FaceId faceId) const
+  {
+    return downFaces.count(faceId) > 0;
+  }
+
+  /**
+   * @returns true if the estimates of a face are recent enough to be trusted (a confidence of at least
+   *          MIN_CONFIDENCE), or if the decay is disabled (confidenceHalfLife is not positive).
+   */
+  static bool hasConfidence(const InterfaceEstimation& faceInfo, time::milliseconds confidenceHalfLife);
+
+  /**
+   * Reads an estimate of a face. If CONFIDENCE_HALF_LIFE is positive, estimates that are no longer
+   * refreshed decay toward the limit of the requirement. Otherwise the current value is returned.
+   */
+  static double getEstimate(const InterfaceEstimation& faceInfo, StrategyRequirements& req, RequirementType type,
+                            time::milliseconds confidenceHalfLife);
+
+  /**
+   * Checks the (decayed) estimates of a face against the requirements of its prefix. A face without
+   * confidence (see hasConfidence()) fails, so it is left to the exploration scheduler to measure it again.
+   *
+   * @param margin Fraction by which the face has to stay within the limits (e.g. 0.1 = 10% better
+   *               than the limits). A negative margin lets the face exceed the limits.
+   * @param confidenceHalfLife See getEstimate().
+   * @returns true if the face meets all requirements.
+   */
+  static bool meetsRequirements(const InterfaceEstimation& faceInfo, StrategyRequirements& req, double margin,
+                                time::milliseconds confidenceHalfLife);
+
+  /**
+   * Checks the delay and loss of a face, projected along their trends, against the requirements.
+   *
+   * @param horizon How far to look ahead (PREDICTIVE_HORIZON).
+   * @returns true if the projected values stay within the limits or if horizon is not positive.
+   */
+  static bool meetsProjectedRequirements(const InterfaceEstimation& faceInfo, StrategyRequirements& req,
+                                         time::milliseconds horizon);
+
+  /**
+   * Selects the outface for a workload Interest if MULTIPATH_ENABLED is set. Push Interests stay
+   * on the face their subscription was established on, as long as that face performs well enough.
+   * Otherwise they move to the selected face and their out-records on other faces are deleted.
+   *
+   * @param state The state of the prefix of the Interest.
+   * @param interest The Interest that should be forwarded.
+   * @param pitEntry The pitEntry of the Interest.
+   * @returns FaceId of the selected face, or the current working face if no face performs well enough.
+   */
+  FaceId selectMultipathOutFaceId(PrefixState& state, const Interest& interest, pit::Entry& pitEntry);
+
+  /**
+   * Re-ranks one face (and updates its multipath weight) after its estimates have changed.
+   * Faces that are down or have Nacked get no headroom, so they neither rank nor take workload.
+   *
+   * @param state The state of the prefix the measurements belong to.
+   * @param faceId The face whose estimates have changed.
+   */
+  void updateFaceRanking(PrefixState& state, FaceId faceId);
+
+  /**
+   * Computes how far the (decayed) estimates of a face stay within the requirements of its prefix.
+   *
+   * @param confidenceHalfLife See getEstimate().
+   * @returns a value in (0, 1] for faces that meet all requirements (1 = idle path),
+   *          or 0 if any requirement is violated or the face has no confidence (see hasConfidence()).
+   */
+  static double getHeadroom(const InterfaceEstimation& faceInfo, StrategyRequirements& req,
+                            time::milliseconds confidenceHalfLife);
 
   /**
    * Tries to return a face by using the original bestRout algorithm. If no face is found this way
@@ -101,6 +335,11 @@ private:
    */
   FaceId getFaceIdViaBestRoute(const fib::NextHopList& nexthops, const shared_ptr<pit::Entry> pitEntry);
 
+  /**
+   * @returns true if the face with the given id is contained in the list of nexthops.
+   */
+  static bool isNextHop(FaceId faceId, const fib::NextHopList& nexthops);
+
   /**
    * Searches a list of nexthops for a face with the given id.
    *
@@ -111,39 +350,85 @@ private:
   Face& getFaceViaId(FaceId faceId , const fib::NextHopList& nexthops);
 
   /**
-   * A simple helper function which helps to regulate tainting decisions.
+   * Selects the alternative face a tainted probe of a prefix should explore.
+   *
+   * @param inFace The face the probe was received on (it is never explored).
+   * @returns the face to explore or face::INVALID_FACEID if there is no usable alternative.
+   */
+  FaceId selectExplorationTarget(PrefixState& state, const Face& inFace,
+                                 const fib::NextHopList& nexthops, const pit::Entry& pitEntry);
+
+  /**
+   * Makes sure the parameters of a prefix are the ones currently specified in ParameterConfiguration.
+   * The snapshot is only fetched again (and the requirements updated) if the configuration has changed.
    *
-   * @returns true every n-th call, where n is the percentage specified in MAX_TAINTED_PROBES_PERCENTAGE.
+   * @param state The state of the prefix for which the parameter values should be refreshed.
+   * @returns the current parameters of the prefix.
    */
-  bool taintingAllowed();
+  const PrefixParameters& refreshParameters(PrefixState& state);
 
   /**
-   * Makes sure all parameters are set according to the values specified in ParameterConfiguration.
+   * Resolves the state of the prefix a pit entry belongs to by a longest prefix match in the
+   * measurements table. Refreshes the parameters of the prefix and extends the lifetime of its
+   * measurements entry.
    *
-   * @param currentPrefix The Prefix for which the parameter values should be refreshed. 
+   * @param pitEntry The pit entry of the Interest, Data or Nack.
+   * @returns the state for the prefix of the pit entry, or nullptr if the prefix is unknown.
    */
-  void refreshParameters(std::string currentPrefix) ;
+  PrefixState* findPrefixState(const pit::Entry& pitEntry);
+
+  /**
+   * Creates the state of a new prefix. Must only be called if findPrefixState() returned nullptr.
+   *
+   * @param pitEntry The pit entry of the Interest.
+   * @returns the newly created state for the prefix of the pit entry.
+   */
+  PrefixState& insertPrefixState(const pit::Entry& pitEntry);
+
+  /**
+   * Forgets the prefixes in knownPrefixes whose measurements have expired.
+   */
+  void pruneKnownPrefixes();
+
+  /**
+   * Keeps the measurements entry of a prefix alive for MEASUREMENT_LIFETIME from now.
+   */
+  void extendPrefixLifetime(measurements::Entry& entry, const PrefixParameters& params);
 
 private:
+  // Confidence below which the estimates of a face no longer count as meeting the requirements.
+  static const double MIN_CONFIDENCE;
+
   StrategyChoice& ownStrategyChoice;
 
-  // Class variables for all the relevant parameters in ParameterConfiguration (for more readable code)
-  std::string PROBE_SUFFIX;
+  Fib& ownFib;
+
+  // Shared (not per-prefix) parameter from ParameterConfiguration
   int PREFIX_OFFSET;
-  bool TAINTING_ENABLED;
-  uint MIN_NUM_OF_FACES_FOR_TAINTING;
-  int MAX_TAINTED_PROBES_PERCENTAGE;
-  double REQUIREMENT_MAXDELAY;
-  double REQUIREMENT_MAXLOSS;
-  double REQUIREMENT_MINBANDWIDTH;
-  double HYSTERESIS_PERCENTAGE;
-  time::nanoseconds RTT_TIME_TABLE_MAX_DURATION; 
-  
-  // Simple counter used in taintingAllowed().
-  int taintingCounter; 
-
-  // A map containing measurements for each prefix this strategy is currently dealing with.
-  std::unordered_map<std::string, MeasurementInfo> measurementMap;
+
+  // Recognizes probes by the PROBE_SUFFIX component directly behind the prefix.
+  const NameMatcher probeMatcher;
+
+  // Number of working path switches suppressed by the flap dampening.
+  uint64_t nSuppressedSwitches;
+
+  // Identity written into the probes tainted by this router, so routers after it can still measure them.
+  const uint64_t tainterId;
+
+  // The prefixes this strategy has created measurements for. Prefixes whose measurements have expired
+  // are forgotten whenever the set has doubled since it was last pruned, and are skipped until then.
+  std::set<Name> knownPrefixes;
+
+  // The number of prefixes in knownPrefixes after it was last pruned.
+  size_t nLiveKnownPrefixes;
+
+  // The faces that are currently down.
+  std::set<FaceId> downFaces;
+
+  // Connections to the afterStateChange signals of all faces.
+  std::unordered_map<FaceId, signal::ScopedConnection> faceStateConnections;
+  signal::ScopedConnection afterAddFaceConnection;
+  signal::ScopedConnection beforeRemoveFaceConnection;
 };
 
 }  // namespace fw
@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "path-selection-stats.hpp"
+
+namespace nfd {
+namespace fw {
+
+PathSelectionStats::PathSelectionStats()
+  : m_nProbes(0)
+  , m_nExplorationProbes(0)
+  , m_absorbedProbeBytes(0)
+  , m_nSwitches(0)
+  , m_isViolating(false)
+  , m_nViolations(0)
+  , m_violationTime(time::steady_clock::Duration::zero())
+  , m_nRecoveries(0)
+  , m_recoveryTime(time::steady_clock::Duration::zero())
+{
+}
+
+void PathSelectionStats::recordProbe(bool isExploration)
+{
+  ++m_nProbes;
+  if (isExploration)
+  {
+    ++m_nExplorationProbes;
+  }
+}
+
+void PathSelectionStats::recordWorkingFaceCheck(bool meetsRequirements, time::steady_clock::TimePoint now)
+{
+  if (!meetsRequirements && !m_isViolating)
+  {
+    m_isViolating = true;
+    m_violationStart = now;
+    ++m_nViolations;
+  }
+  else if (meetsRequirements && m_isViolating)
+  {
+    m_isViolating = false;
+    m_violationTime += now - m_violationStart;
+  }
+}
+
+void PathSelectionStats::checkWorkingFace(const InterfaceEstimation& faceInfo, StrategyRequirements& req,
+                                          time::steady_clock::TimePoint now)
+{
+  recordWorkingFaceCheck(faceInfo.getCurrentValue(RequirementType::DELAY) <= req.getLimit(RequirementType::DELAY) &&
+                         faceInfo.getCurrentValue(RequirementType::LOSS) <= req.getLimit(RequirementType::LOSS) &&
+                         faceInfo.getCurrentValue(RequirementType::BANDWIDTH) >= req.getLimit(RequirementType::BANDWIDTH),
+                         now);
+}
+
+void PathSelectionStats::print(std::ostream& os, time::steady_clock::TimePoint now) const
+{
+  time::steady_clock::Duration violationTime = m_violationTime;
+  if (m_isViolating)
+  {
+    violationTime += now - m_violationStart;
+  }
+  double violationMs = time::duration_cast<time::microseconds>(violationTime).count() / 1000.0;
+  double recoveryMs = time::duration_cast<time::microseconds>(m_recoveryTime).count() / 1000.0;
+
+  os << "probes=" << m_nProbes
+     << " explorationProbes=" << m_nExplorationProbes
+     << " probeOverhead=" << (m_nProbes > 0 ? static_cast<double>(m_nExplorationProbes) / m_nProbes : 0)
+     << " absorbedProbeBytes=" << m_absorbedProbeBytes
+     << " switches=" << m_nSwitches
+     << " violations=" << m_nViolations
+     << " violationTimeMs=" << violationMs
+     << " meanTimeToConvergeMs=" << (m_nViolations > 0 ? violationMs / m_nViolations : 0)
+     << " recoveries=" << m_nRecoveries
+     << " recoveryTimeMs=" << recoveryMs
+     << " meanRecoveryTimeMs=" << (m_nRecoveries > 0 ? recoveryMs / m_nRecoveries : 0);
+}
+
+}  // namespace fw
+}  // namespace nfd
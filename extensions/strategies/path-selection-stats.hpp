@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NFD_DAEMON_FW_PATH_SELECTION_STATS_HPP
+#define NFD_DAEMON_FW_PATH_SELECTION_STATS_HPP
+
+#include "fw/../../core/common.hpp"
+#include "fw/interface-estimation.hpp"
+#include "fw/strategy-requirements.hpp"
+#include <ostream>
+#include <string>
+
+namespace nfd {
+namespace fw {
+
+/**
+ * Counts how one prefix is served by a path selecting strategy, so strategies can be compared:
+ * the share of probes spent on exploring alternatives (and the Data of them that did not travel
+ * further back than the exploring router), the working path switches, how long (in total and
+ * per episode) the working path did not meet the requirements, and how long it took to recover
+ * from failed working faces.
+ */
+class PathSelectionStats
+{
+public:
+  PathSelectionStats();
+
+  /**
+   * Counts a probe that was used for measurements.
+   *
+   * @param isExploration true if the probe was sent on an alternative path.
+   */
+  void recordProbe(bool isExploration);
+
+  /**
+   * Counts the Data of an exploration probe that was consumed by this router instead of being
+   * forwarded back towards the consumer.
+   *
+   * @param size The size of the Data packet in bytes.
+   */
+  void recordAbsorbedProbe(size_t size)
+  {
+    m_absorbedProbeBytes += size;
+  }
+
+  /**
+   * Counts a working path switch.
+   */
+  void recordSwitch()
+  {
+    ++m_nSwitches;
+  }
+
+  /**
+   * Counts the recovery from a failed working face.
+   *
+   * @param recoveryTime The time from the failover until Data arrived on the new working face.
+   */
+  void recordRecovery(time::steady_clock::Duration recoveryTime)
+  {
+    ++m_nRecoveries;
+    m_recoveryTime += recoveryTime;
+  }
+
+  /**
+   * Records whether the working path currently meets the requirements. An episode of violation
+   * lasts from the first check that fails until the next check that passes.
+   */
+  void recordWorkingFaceCheck(bool meetsRequirements, time::steady_clock::TimePoint now);
+
+  /**
+   * Checks the current estimates of the working face against the requirements and records the result
+   * (see recordWorkingFaceCheck()). All strategies judge their working faces by this check, on the face
+   * that was working when a probe arrived (before the strategy possibly switches), so their violation
+   * times are comparable.
+   */
+  void checkWorkingFace(const InterfaceEstimation& faceInfo, StrategyRequirements& req,
+                        time::steady_clock::TimePoint now);
+
+  /**
+   * Prints the statistics as one line of key=value pairs (an ongoing violation is counted up to now).
+   */
+  void print(std::ostream& os, time::steady_clock::TimePoint now) const;
+
+private:
+  uint64_t m_nProbes;
+  uint64_t m_nExplorationProbes;
+  uint64_t m_absorbedProbeBytes;
+  uint64_t m_nSwitches;
+
+  bool m_isViolating;
+  time::steady_clock::TimePoint m_violationStart;
+  uint64_t m_nViolations;
+  time::steady_clock::Duration m_violationTime;
+
+  uint64_t m_nRecoveries;
+  time::steady_clock::Duration m_recoveryTime;
+};
+
+/**
+ * Implemented by strategies that keep PathSelectionStats for their prefixes.
+ */
+class PathSelectionReporter
+{
+public:
+  virtual
+  ~PathSelectionReporter() = default;
+
+  /**
+   * Prints one line per prefix, each starting with label.
+   */
+  virtual void
+  printPathSelectionStats(std::ostream& os, const std::string& label) = 0;
+};
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif
@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "switch-dampener.hpp"
+#include <cmath>
+
+namespace nfd {
+namespace fw {
+
+SwitchDampener::SwitchDampener(time::steady_clock::TimePoint now)
+  : m_lastSwitch(now)
+  , m_nSuppressedSwitches(0)
+{
+}
+
+void SwitchDampener::recordSwitch(FaceId oldFaceId, time::steady_clock::TimePoint now, time::milliseconds halfLife)
+{
+  m_lastSwitch = now;
+  if (halfLife <= time::milliseconds::zero())
+  {
+    return;
+  }
+
+  auto it = m_penalties.find(oldFaceId);
+  if (it == m_penalties.end())
+  {
+    m_penalties[oldFaceId] = {1, now};
+  }
+  else
+  {
+    it->second.value = decay(it->second, now, halfLife) + 1;
+    it->second.lastUpdate = now;
+  }
+}
+
+bool SwitchDampener::isDwelling(time::steady_clock::TimePoint now, time::milliseconds minDwellTime) const
+{
+  return now - m_lastSwitch < minDwellTime;
+}
+
+double SwitchDampener::getPenalty(FaceId faceId, time::steady_clock::TimePoint now, time::milliseconds halfLife) const
+{
+  auto it = m_penalties.find(faceId);
+  if (it == m_penalties.end() || halfLife <= time::milliseconds::zero())
+  {
+    return 0;
+  }
+  return decay(it->second, now, halfLife);
+}
+
+double SwitchDampener::decay(const Penalty& penalty, time::steady_clock::TimePoint now, time::milliseconds halfLife)
+{
+  double halfLives = time::duration_cast<time::microseconds>(now - penalty.lastUpdate).count() /
+                     static_cast<double>(time::duration_cast<time::microseconds>(halfLife).count());
+  return penalty.value * std::pow(0.5, halfLives);
+}
+
+}  // namespace fw
+}  // namespace nfd
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NFD_DAEMON_FW_SWITCH_DAMPENER_HPP
+#define NFD_DAEMON_FW_SWITCH_DAMPENER_HPP
+
+#include "fw/../../core/common.hpp"
+#include "fw/../face/face.hpp"
+#include <unordered_map>
+
+namespace nfd {
+namespace fw {
+
+/**
+ * Dampens working path switches of one prefix. After a switch the new working face has to be kept
+ * for a minimum dwell time, and every face that was left collects a flap penalty which decays
+ * exponentially. Faces with a high penalty are not switched to until their penalty has decayed.
+ */
+class SwitchDampener
+{
+public:
+  /**
+   * @param now The time the working face of the prefix was first selected.
+   */
+  explicit
+  SwitchDampener(time::steady_clock::TimePoint now);
+
+  /**
+   * Records a switch of the working face.
+   *
+   * @param oldFaceId The working face that was left (it receives a flap penalty of 1).
+   * @param halfLife The half-life of flap penalties (0 disables penalties).
+   */
+  void recordSwitch(FaceId oldFaceId, time::steady_clock::TimePoint now, time::milliseconds halfLife);
+
+  /**
+   * @returns true if the working face was selected less than minDwellTime ago.
+   */
+  bool isDwelling(time::steady_clock::TimePoint now, time::milliseconds minDwellTime) const;
+
+  /**
+   * @returns the decayed flap penalty of a face.
+   */
+  double getPenalty(FaceId faceId, time::steady_clock::TimePoint now, time::milliseconds halfLife) const;
+
+  /**
+   * Forgets the flap penalty of a face (e.g. because it was removed).
+   */
+  void removeFace(FaceId faceId)
+  {
+    m_penalties.erase(faceId);
+  }
+
+  /**
+   * Counts a switch that was suppressed by the dampening.
+   */
+  void recordSuppressedSwitch()
+  {
+    ++m_nSuppressedSwitches;
+  }
+
+  /**
+   * @returns the number of switches that were suppressed so far.
+   */
+  uint64_t getSuppressedSwitches() const
+  {
+    return m_nSuppressedSwitches;
+  }
+
+private:
+  struct Penalty
+  {
+    double value;
+    time::steady_clock::TimePoint lastUpdate;
+  };
+
+  static double decay(const Penalty& penalty, time::steady_clock::TimePoint now, time::milliseconds halfLife);
+
+private:
+  // The time of the last switch (or of the first selection of a working face).
+  time::steady_clock::TimePoint m_lastSwitch;
+
+  // The flap penalties of faces that have been left as working face.
+  std::unordered_map<FaceId, Penalty> m_penalties;
+
+  uint64_t m_nSuppressedSwitches;
+};
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif
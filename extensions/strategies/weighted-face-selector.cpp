@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "weighted-face-selector.hpp"
+#include <algorithm>
+
+namespace nfd {
+namespace fw {
+
+WeightedFaceSelector::WeightedFaceSelector()
+  : m_totalWeight(0)
+{
+}
+
+void WeightedFaceSelector::setWeight(FaceId faceId, double weight)
+{
+  auto it = find(faceId);
+  if (it == m_slots.end())
+  {
+    if (weight > 0)
+    {
+      m_slots.push_back({faceId, weight, 0});
+      m_totalWeight += weight;
+    }
+    return;
+  }
+
+  m_totalWeight -= it->weight;
+  if (weight > 0)
+  {
+    it->weight = weight;
+    m_totalWeight += weight;
+  }
+  else
+  {
+    m_slots.erase(it);
+  }
+}
+
+bool WeightedFaceSelector::contains(FaceId faceId) const
+{
+  return std::any_of(m_slots.begin(), m_slots.end(),
+                     [faceId] (const Slot& slot) { return slot.faceId == faceId; });
+}
+
+FaceId WeightedFaceSelector::select()
+{
+  // Every face gains its weight, the one ahead the most is chosen and pays for all others
+  Slot* best = nullptr;
+  for (Slot& slot : m_slots)
+  {
+    slot.current += slot.weight;
+    if (best == nullptr || slot.current > best->current)
+    {
+      best = &slot;
+    }
+  }
+  if (best == nullptr)
+  {
+    return face::INVALID_FACEID;
+  }
+  best->current -= m_totalWeight;
+  return best->faceId;
+}
+
+std::vector<WeightedFaceSelector::Slot>::iterator WeightedFaceSelector::find(FaceId faceId)
+{
+  return std::find_if(m_slots.begin(), m_slots.end(),
+                      [faceId] (const Slot& slot) { return slot.faceId == faceId; });
+}
+
+}  // namespace fw
+}  // namespace nfd
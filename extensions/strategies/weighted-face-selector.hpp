@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NFD_DAEMON_FW_WEIGHTED_FACE_SELECTOR_HPP
+#define NFD_DAEMON_FW_WEIGHTED_FACE_SELECTOR_HPP
+
+#include "fw/../face/face.hpp"
+#include <vector>
+
+namespace nfd {
+namespace fw {
+
+/**
+ * Splits traffic over a set of faces in proportion to their weights (smooth weighted round robin).
+ *
+ * Weights are set face by face whenever the estimates of a face change, so nothing has to be
+ * recomputed for the faces whose estimates stayed the same.
+ */
+class WeightedFaceSelector
+{
+public:
+  WeightedFaceSelector();
+
+  /**
+   * Sets the weight of a face. A weight <= 0 removes the face from the rotation.
+   */
+  void setWeight(FaceId faceId, double weight);
+
+  /**
+   * @returns true if the face currently takes part in the rotation.
+   */
+  bool contains(FaceId faceId) const;
+
+  /**
+   * @returns the face that should receive the next Interest.
+   * @returns face::INVALID_FACEID if no face has a positive weight.
+   */
+  FaceId select();
+
+private:
+  struct Slot
+  {
+    FaceId faceId;
+    double weight;
+    double current;
+  };
+
+  std::vector<Slot>::iterator find(FaceId faceId);
+
+private:
+  // One slot per face with a positive weight.
+  std::vector<Slot> m_slots;
+
+  // The sum of all weights in m_slots.
+  double m_totalWeight;
+};
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif
@@ -31,6 +31,8 @@
 
 #include "ns3/ndnSIM/ndn-cxx/lp/tags.hpp"
 
+#include "../utils/namematcher.h"
+
 #include <fstream>
 #include <boost/lexical_cast.hpp>
 
@@ -42,6 +44,9 @@ namespace ndn {
 static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<PushTracer>>>>
   g_tracers;
 
+// Traffic that is traced even though it is not pushed (a "voip" component anywhere in the name)
+static const NameMatcher g_voipMatcher("/voip");
+
 void
 PushTracer::Destroy()
 {
@@ -270,7 +275,7 @@ void PushTracer::OutInterests(const Interest& interest, const Face& face)
 
 void PushTracer::InInterests(const Interest& interest, const Face& face)
 {
-  bool voip = interest.getName().toUri().find("voip") != std::string::npos;
+  bool voip = g_voipMatcher.matches(interest.getName());
   if (interest.isPush() || interest.isPushRefresh() || voip) {
 
     int hopCount = 0;
@@ -296,7 +301,7 @@ void PushTracer::InInterests(const Interest& interest, const Face& face)
 
 void PushTracer::OutData(const Data& data, const Face& face)
 {
-  bool voip = data.getName().toUri().find("voip") != std::string::npos;
+  bool voip = g_voipMatcher.matches(data.getName());
 
   if (data.isPush() || voip) {
     int hopCount = 0;
@@ -323,7 +328,7 @@ void PushTracer::OutData(const Data& data, const Face& face)
 
 void PushTracer::InData(const Data& data, const Face& face)
 {
-  bool voip = data.getName().toUri().find("voip") != std::string::npos;
+  bool voip = g_voipMatcher.matches(data.getName());
 
   if (data.isPush() || voip) {
     int hopCount = 0;
@@ -0,0 +1,61 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "namematcher.h"
+
+#include <cstring>
+
+NameMatcher::NameMatcher(const std::string& components, ssize_t offset)
+  : m_components(components)
+  , m_offset(offset)
+{
+}
+
+bool NameMatcher::matches(const ndn::Name& name) const
+{
+  if (m_components.empty())
+    return false;
+
+  if (m_offset != ANY_OFFSET)
+    return matchesAt(name, m_offset);
+
+  for (size_t offset = 0; offset + m_components.size() <= name.size(); ++offset) {
+    if (matchesAt(name, offset))
+      return true;
+  }
+  return false;
+}
+
+bool NameMatcher::matchesAt(const ndn::Name& name, size_t offset) const
+{
+  if (offset + m_components.size() > name.size())
+    return false;
+
+  for (size_t i = 0; i < m_components.size(); ++i) {
+    const ndn::name::Component& expected = m_components.get(i);
+    const ndn::name::Component& actual = name.get(offset + i);
+
+    // Compare type and length first, the value bytes only if those are equal
+    if (actual.type() != expected.type() || actual.value_size() != expected.value_size())
+      return false;
+    if (std::memcmp(actual.value(), expected.value(), expected.value_size()) != 0)
+      return false;
+  }
+  return true;
+}
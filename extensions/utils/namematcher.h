@@ -0,0 +1,64 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NAMEMATCHER_H
+#define NAMEMATCHER_H
+
+#include <ndn-cxx/name.hpp>
+#include <string>
+
+/**
+ * The NameMatcher class checks if a name contains a given sequence of name components
+ * (e.g. the PROBE_SUFFIX). The components are parsed once on construction and compared
+ * directly with the components of a name, so the name never has to be converted to a URI.
+ */
+class NameMatcher
+{
+public:
+  // Offset which makes the matcher look for the components at every position of a name.
+  static const ssize_t ANY_OFFSET = -1;
+
+  /**
+   * @param components The components to look for as URI, e.g. "/probe".
+   * @param offset The position at which the components are expected in a name (e.g. PREFIX_OFFSET),
+   *               or ANY_OFFSET if they may appear anywhere.
+   */
+  NameMatcher(const std::string& components, ssize_t offset = ANY_OFFSET);
+
+  /**
+   * @param name The name that should be checked.
+   * @returns true if name contains the components at the configured offset.
+   */
+  bool matches(const ndn::Name& name) const;
+
+private:
+  /**
+   * @returns true if the components of name starting at position offset equal m_components.
+   */
+  bool matchesAt(const ndn::Name& name, size_t offset) const;
+
+private:
+  // The precompiled components to look for.
+  const ndn::Name m_components;
+
+  // The position of the components in a name (or ANY_OFFSET).
+  const ssize_t m_offset;
+};
+
+#endif // NAMEMATCHER_H
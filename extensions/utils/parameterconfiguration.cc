@@ -30,12 +30,28 @@ ParameterConfiguration::ParameterConfiguration()
   setParameter("REQUIREMENT_MAXLOSS", P_REQUIREMENT_MAXLOSS);
   setParameter("REQUIREMENT_MINBANDWIDTH", P_REQUIREMENT_MINBANDWIDTH);
   setParameter("RTT_TIME_TABLE_MAX_DURATION", P_RTT_TIME_TABLE_MAX_DURATION);
+  setParameter("HYSTERESIS_PERCENTAGE", P_HYSTERESIS_PERCENTAGE);
+  setParameter("HYSTERESIS_EXIT_PERCENTAGE", P_HYSTERESIS_EXIT_PERCENTAGE);
+  setParameter("MIN_DWELL_TIME", P_MIN_DWELL_TIME);
+  setParameter("FLAP_PENALTY_HALF_LIFE", P_FLAP_PENALTY_HALF_LIFE);
+  setParameter("FLAP_PENALTY_LIMIT", P_FLAP_PENALTY_LIMIT);
+  setParameter("MEASUREMENT_LIFETIME", P_MEASUREMENT_LIFETIME);
+  setParameter("MULTIPATH_ENABLED", P_MULTIPATH_ENABLED);
+  setParameter("PREDICTIVE_HORIZON", P_PREDICTIVE_HORIZON);
+  setParameter("CONFIDENCE_HALF_LIFE", P_CONFIDENCE_HALF_LIFE);
+  setParameter("BANDWIDTH_BUCKETS", P_BANDWIDTH_BUCKETS);
+  setParameter("BANDWIDTH_EWMA_GAIN", P_BANDWIDTH_EWMA_GAIN);
+  setParameter("FAILOVER_PROBE_TIMEOUTS", P_FAILOVER_PROBE_TIMEOUTS);
 }
 
 
 void ParameterConfiguration::setParameter(std::string param_name, double value, std::string prefix)
 {
   prefixMap[prefix][param_name] = value;
+
+  // Outdate all published snapshots
+  generation++;
+  snapshotMap.clear();
 }
 
 double ParameterConfiguration::getParameter(std::string param_name, std::string prefix)
@@ -43,6 +59,57 @@ double ParameterConfiguration::getParameter(std::string param_name, std::string
   return prefixMap[prefix][param_name];
 }
 
+double ParameterConfiguration::lookupParameter(const std::string& param_name, const std::string& prefix) const
+{
+  auto prefixIt = prefixMap.find(prefix);
+  if (prefixIt != prefixMap.end()) {
+    auto paramIt = prefixIt->second.find(param_name);
+    if (paramIt != prefixIt->second.end())
+      return paramIt->second;
+  }
+
+  // Fall back to the default value
+  prefixIt = prefixMap.find("/");
+  if (prefixIt != prefixMap.end()) {
+    auto paramIt = prefixIt->second.find(param_name);
+    if (paramIt != prefixIt->second.end())
+      return paramIt->second;
+  }
+  return 0;
+}
+
+std::shared_ptr<const PrefixParameters> ParameterConfiguration::getPrefixParameters(const std::string& prefix)
+{
+  auto it = snapshotMap.find(prefix);
+  if (it != snapshotMap.end())
+    return it->second;
+
+  std::shared_ptr<PrefixParameters> snapshot = std::make_shared<PrefixParameters>();
+  snapshot->generation = generation;
+  snapshot->taintingEnabled = lookupParameter("TAINTING_ENABLED", prefix) != 0;
+  snapshot->minNumOfFacesForTainting = lookupParameter("MIN_NUM_OF_FACES_FOR_TAINTING", prefix);
+  snapshot->maxTaintedProbesPercentage = lookupParameter("MAX_TAINTED_PROBES_PERCENTAGE", prefix);
+  snapshot->requirementMaxDelay = lookupParameter("REQUIREMENT_MAXDELAY", prefix);
+  snapshot->requirementMaxLoss = lookupParameter("REQUIREMENT_MAXLOSS", prefix);
+  snapshot->requirementMinBandwidth = lookupParameter("REQUIREMENT_MINBANDWIDTH", prefix);
+  snapshot->hysteresisPercentage = lookupParameter("HYSTERESIS_PERCENTAGE", prefix);
+  snapshot->hysteresisExitPercentage = lookupParameter("HYSTERESIS_EXIT_PERCENTAGE", prefix);
+  snapshot->minDwellTime = lookupParameter("MIN_DWELL_TIME", prefix);
+  snapshot->flapPenaltyHalfLife = lookupParameter("FLAP_PENALTY_HALF_LIFE", prefix);
+  snapshot->flapPenaltyLimit = lookupParameter("FLAP_PENALTY_LIMIT", prefix);
+  snapshot->rttTimeTableMaxDuration = lookupParameter("RTT_TIME_TABLE_MAX_DURATION", prefix);
+  snapshot->measurementLifetime = lookupParameter("MEASUREMENT_LIFETIME", prefix);
+  snapshot->multipathEnabled = lookupParameter("MULTIPATH_ENABLED", prefix) != 0;
+  snapshot->predictiveHorizon = lookupParameter("PREDICTIVE_HORIZON", prefix);
+  snapshot->confidenceHalfLife = lookupParameter("CONFIDENCE_HALF_LIFE", prefix);
+  snapshot->bandwidthBuckets = lookupParameter("BANDWIDTH_BUCKETS", prefix);
+  snapshot->bandwidthEwmaGain = lookupParameter("BANDWIDTH_EWMA_GAIN", prefix);
+  snapshot->failoverProbeTimeouts = lookupParameter("FAILOVER_PROBE_TIMEOUTS", prefix);
+
+  snapshotMap[prefix] = snapshot;
+  return snapshot;
+}
+
 ParameterConfiguration *ParameterConfiguration::getInstance()
 {
   if(instance == NULL)
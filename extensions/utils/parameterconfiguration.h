@@ -21,7 +21,9 @@
 #define PARAMETERCONFIGURATION_H
 
 #include <cstddef>
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
 
 //per-prefix parameters
@@ -31,7 +33,51 @@
 #define P_REQUIREMENT_MAXDELAY          200.0  // maximum tolerated delay in milliseconds
 #define P_REQUIREMENT_MAXLOSS           0.1    // maximum tolerated loss in percentage
 #define P_REQUIREMENT_MINBANDWIDTH      0.0    // minimum tolerated bandwith in Kbps
-#define P_RTT_TIME_TABLE_MAX_DURATION   1000   // maximum time (in milliseconds) an entry is kept in the rttMap before being erased
+#define P_RTT_TIME_TABLE_MAX_DURATION   1000   // maximum RTT (in milliseconds) that is still accepted as a measurement sample
+#define P_HYSTERESIS_PERCENTAGE         0.0    // percentage by which a path has to be better than the limits before it is switched to
+#define P_HYSTERESIS_EXIT_PERCENTAGE    0.0    // percentage by which the working path may exceed the limits before it is left
+#define P_MIN_DWELL_TIME                0      // minimum time (in milliseconds) a working path is kept after a switch
+#define P_FLAP_PENALTY_HALF_LIFE        0      // half-life (in milliseconds) of the penalty a face gets when it is left; 0=disabled
+#define P_FLAP_PENALTY_LIMIT            3.0    // penalty from which on a face is not switched to
+#define P_MEASUREMENT_LIFETIME          10000  // time (in milliseconds) the measurements of an idle prefix are kept
+#define P_MULTIPATH_ENABLED             0      // splits workload over all well-performing faces by their headroom; 1=true, 0=false
+#define P_PREDICTIVE_HORIZON            0      // time (in milliseconds) ahead a trend may not cross the limits before the working path is left; 0=disabled
+#define P_CONFIDENCE_HALF_LIFE          0      // half-life (in milliseconds) of the confidence in estimates that are no longer measured; 0=disabled
+#define P_BANDWIDTH_BUCKETS             50     // number of time buckets the window of the bandwidth estimators is divided into
+#define P_BANDWIDTH_EWMA_GAIN           0.0    // gain per second of the moving average over the windowed bandwidth; 0=disabled
+#define P_FAILOVER_PROBE_TIMEOUTS       3      // number of consecutive probe timeouts after which the working face counts as failed; 0=disabled
+
+/**
+ * An immutable snapshot of all per-prefix parameters of one prefix.
+ *
+ * Snapshots are published by ParameterConfiguration::getPrefixParameters() and are never modified
+ * afterwards. They can be cached as long as their generation equals ParameterConfiguration::getGeneration().
+ */
+struct PrefixParameters
+{
+  // The generation of the ParameterConfiguration this snapshot was taken from.
+  uint64_t generation;
+
+  bool taintingEnabled;
+  uint32_t minNumOfFacesForTainting;
+  int maxTaintedProbesPercentage;
+  double requirementMaxDelay;
+  double requirementMaxLoss;
+  double requirementMinBandwidth;
+  double hysteresisPercentage;
+  double hysteresisExitPercentage;
+  int minDwellTime; // in milliseconds
+  int flapPenaltyHalfLife; // in milliseconds
+  double flapPenaltyLimit;
+  int rttTimeTableMaxDuration; // in milliseconds
+  int measurementLifetime; // in milliseconds
+  bool multipathEnabled;
+  int predictiveHorizon; // in milliseconds
+  int confidenceHalfLife; // in milliseconds
+  int bandwidthBuckets;
+  double bandwidthEwmaGain;
+  int failoverProbeTimeouts;
+};
 
 /**
  * The ParameterConfiguration class is used to set/get parameters to configure the lowest-cost-strategy.
@@ -70,9 +116,31 @@ public:
    */
   double getParameter(std::string param_name, std::string prefix = "/");
 
+  /**
+   * Gets a snapshot of all per-prefix parameters. Parameters that were not set for the prefix
+   * are taken from the defaults (prefix "/").
+   *
+   * @param prefix The prefix the parameters should be fetched for.
+   * @returns the snapshot, which stays valid (but possibly outdated) even if parameters change later.
+   */
+  std::shared_ptr<const PrefixParameters> getPrefixParameters(const std::string& prefix);
+
+  /**
+   * @returns the current generation, which is incremented with every call to setParameter().
+   */
+  uint64_t getGeneration() const
+  {
+    return generation;
+  }
+
 protected:  
   ParameterConfiguration();
 
+  /**
+   * Gets a parameter for a prefix, falling back to the default (prefix "/") if it was not set for it.
+   */
+  double lookupParameter(const std::string& param_name, const std::string& prefix) const;
+
   std::map<std::string, double> typedef ParameterMap; // <param name, param value>
 
   // The singleton instance.
@@ -84,6 +152,12 @@ protected:
   // A map containing one ParameterMap per prefix.
   std::map<std::string, ParameterMap> prefixMap;
 
+  // The snapshots published for the current generation, per prefix.
+  std::map<std::string, std::shared_ptr<const PrefixParameters>> snapshotMap;
+
+  // Incremented whenever a parameter changes, which invalidates all published snapshots.
+  uint64_t generation = 0;
+
 
 };
 
@@ -19,39 +19,41 @@
  */
 
 #include "bandwidth-estimator.hpp"
+#include <cmath>
 
 namespace nfd {
 namespace fw {
 
-BandwidthEstimator::BandwidthEstimator(time::steady_clock::duration window) :
-    windowSize(window)
+BandwidthEstimator::BandwidthEstimator(time::steady_clock::duration window, int nBuckets, double ewmaGain) :
+    windowSize(window), bwBuckets(window, nBuckets), totalSize(0), ewmaGain(ewmaGain), ewmaRate(0),
+    hasEwmaRate(false), lastUpdate(time::steady_clock::TimePoint::min())
 {
 }
 
+const int BandwidthEstimator::NUM_BUCKETS;
+
 void BandwidthEstimator::addPacket(size_t sizeInBytes)
 {
   time::steady_clock::TimePoint now = time::steady_clock::now();
-  bwMap[now] = sizeInBytes;
+  expire(now);
+  *bwBuckets.find(now, now) += sizeInBytes;
+  totalSize += sizeInBytes;
+  lastUpdate = now;
 }
 
-double BandwidthEstimator::getKBytesPerSecond()
+double BandwidthEstimator::getKBytesPerSecond() const
 {
-  time::steady_clock::time_point now = time::steady_clock::now();
-
-  // Remove too early data packets
-  time::steady_clock::TimePoint lastValidInterests = now - windowSize;
-  bwMap.erase(bwMap.begin(), bwMap.upper_bound(lastValidInterests));
+  if (ewmaGain > 0) {
+    return ewmaRate;
+  }
+  expire(time::steady_clock::now());
 
   // Return 0 if no packets are inside the sliding window
-  if (bwMap.size() == 0) {
+  if (totalSize == 0) {
     return 0;
   }
   // Else return the data rate
   else {
-    size_t totalSize = 0;
-    for (auto n : bwMap) {
-      totalSize += n.second;
-    }
     double windowSeconds = windowSize.count() / 1000000000.0;
     double kiloBytesPerSec = (double) totalSize / ((double) windowSeconds * 1024);
 
@@ -59,5 +61,32 @@ double BandwidthEstimator::getKBytesPerSecond()
   }
 }
 
+void BandwidthEstimator::updateMeasurements()
+{
+  time::steady_clock::time_point now = time::steady_clock::now();
+
+  expire(now);
+
+  if (ewmaGain > 0) {
+    double windowSeconds = windowSize.count() / 1000000000.0;
+    double kiloBytesPerSec = (double) totalSize / (windowSeconds * 1024);
+    if (hasEwmaRate) {
+      // Apply the gain once per elapsed second, since advancing is lazy and the samples are irregular
+      double elapsedSeconds = time::duration_cast<time::microseconds>(now - ewmaSampleTime).count() / 1000000.0;
+      ewmaRate += (kiloBytesPerSec - ewmaRate) * (1 - std::pow(1 - ewmaGain, elapsedSeconds));
+    }
+    else {
+      ewmaRate = kiloBytesPerSec;
+      hasEwmaRate = true;
+    }
+    ewmaSampleTime = now;
+  }
+}
+
+void BandwidthEstimator::expire(time::steady_clock::TimePoint now) const
+{
+  bwBuckets.expire(now, [this] (uint64_t bytes) { totalSize -= bytes; });
+}
+
 }  // namespace fw
 }  // namespace nfd
\ No newline at end of file
@@ -24,14 +24,17 @@
 #include "common.hpp"
 #include <boost/chrono/duration.hpp>
 #include <ndn-cxx/util/time.hpp>
-#include <map>
+#include "time-bucket-window.hpp"
 
 namespace nfd {
 namespace fw {
 
 /**
  * Implements a bandwidth estimator using a simple moving average.
- * The average bandwidth is calculated over a sliding window of x time units.
+ * The average bandwidth is calculated over a sliding window of x time units, whose bytes are
+ * summed up in a fixed number of time buckets (the resolution of the window) and kept as a running
+ * total, from which a bucket is subtracted as soon as it leaves the window. Adding a packet and
+ * reading the bandwidth take constant amortized time, and the memory does not depend on the packet rate. Optionally, the rate is smoothed further by an exponential moving average.
  */
 class BandwidthEstimator
 {
@@ -41,8 +44,12 @@ public:
    * Constructs the bandwidth estimator and sets the sliding window size
    *
    * @param window the sliding window size
+   * @param nBuckets the number of time buckets the window is divided into
+   * @param ewmaGain the gain per second of the exponential moving average over the windowed rate
+   *                 (0 reports the windowed rate as it is). Samples that are further apart weigh
+   *                 more, so irregular updateMeasurements() calls do not change its meaning.
    */
-  BandwidthEstimator(time::steady_clock::duration window);
+  BandwidthEstimator(time::steady_clock::duration window, int nBuckets = NUM_BUCKETS, double ewmaGain = 0);
 
   /**
    * Adds one interest or data packet to the bandwidth calculation.
@@ -53,19 +60,65 @@ public:
   addPacket(size_t sizeInBytes);
 
   /**
+   * Computed from the running total (or the moving average, if enabled). Buckets that have left
+   * the window are subtracted from the total first, which takes constant amortized time.
+   *
    * @returns the bandwidth over the sliding window in kilobytes per second (1 KB = 1024 bytes).
    * @returns 0 if there were no data packets inside the time window.
    */
   double
-  getKBytesPerSecond();
+  getKBytesPerSecond() const;
+
+  /**
+   * @returns the time the last packet was added, or TimePoint::min() if there was none yet.
+   */
+  time::steady_clock::TimePoint
+  getLastUpdate() const
+  {
+    return lastUpdate;
+  }
+
+  /**
+   * Samples the moving average. Called by InterfaceEstimation::advance() at most once per
+   * REFRESH_INTERVAL_IN_MS.
+   */
+  void
+  updateMeasurements();
+
+public:
+
+  // The default number of time buckets the window is divided into
+  static const int NUM_BUCKETS = 50;
+
+private:
+
+  /**
+   * Subtracts the buckets that have left the window from totalSize.
+   */
+  void
+  expire(time::steady_clock::TimePoint now) const;
 
 private:
 
   // The sliding window size
   const time::steady_clock::duration windowSize;
 
-  // A map of time stamps and corresponding size of packets
-  std::map<time::steady_clock::TimePoint, size_t> bwMap;
+  // The bytes of the packets added during each bucket (the window is the last nBuckets of them)
+  mutable TimeBucketWindow<uint64_t> bwBuckets;
+
+  // The sum of all packet sizes inside the window (mutable, since reads expire old buckets)
+  mutable uint64_t totalSize;
+
+  // The gain of the moving average (0 if disabled) and its current value in KB/s
+  const double ewmaGain;
+  double ewmaRate;
+  bool hasEwmaRate;
+
+  // The time the moving average was last sampled
+  time::steady_clock::TimePoint ewmaSampleTime;
+
+  // The time the last packet was added
+  time::steady_clock::TimePoint lastUpdate;
 
 };
 
@@ -27,6 +27,7 @@
 #include "algorithm.hpp"
 #include "core/logger.hpp"
 #include "strategy.hpp"
+#include "out-record-info.hpp"
 #include "table/cleanup.hpp"
 #include <ndn-cxx/lp/tags.hpp>
 #include "face/null-face.hpp"
@@ -264,8 +265,9 @@ Forwarder::onOutgoingInterest(const shared_ptr<pit::Entry>& pitEntry, Face& outF
   NFD_LOG_DEBUG("onOutgoingInterest face=" << outFace.getId() <<
                 " interest=" << pitEntry->getInterest().toUri()); 
 
-  // insert out-record
-  pitEntry->insertOrUpdateOutRecord(outFace, interest);
+  // insert out-record and remember when the Interest was sent (used by strategies for RTT measurements)
+  pit::OutRecordCollection::iterator outRecord = pitEntry->insertOrUpdateOutRecord(outFace, interest);
+  outRecord->insertStrategyInfo<fw::OutRecordInfo>().first->sendTime = time::steady_clock::now();
 
   // send Interest
   outFace.sendInterest(interest);
@@ -362,6 +364,15 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
   for (const shared_ptr<pit::Entry>& pitEntry : pitMatches) {
     NFD_LOG_DEBUG("onIncomingData matching=" << pitEntry->getName());
 
+    // Push Data is only accepted from the faces a subscription is anchored on. This allows a strategy
+    // to move a subscription by deleting the out-record of the old face, which then lapses upstream.
+    if (data.isPush() && pitEntry->getInterest().isPush() &&
+        pitEntry->getOutRecord(inFace) == pitEntry->getOutRecords().end()) {
+      NFD_LOG_DEBUG("onIncomingData push data=" << data.getName() << " from face=" << inFace.getId() <<
+                    " without out-record, ignored");
+      continue;
+    }
+
 /*    uint8_t bloom_limit = 200; 
     uint8_t bloom_failure_limit = 5; 
  
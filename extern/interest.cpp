@@ -267,6 +267,10 @@ Interest::wireEncode(EncodingImpl<TAG>& encoder) const
     totalLength += prependNonNegativeIntegerBlock(encoder, tlv::QCI, m_qci); 
   } 
 
+  if (m_taintedBy != 0) {
+    totalLength += prependNonNegativeIntegerBlock(encoder, tlv::TaintedBy, m_taintedBy);
+  }
+
   // Name
   totalLength += getName().wireEncode(encoder);
 
@@ -367,6 +371,14 @@ Interest::wireDecode(const Block& wire)
   if (val != m_wire.elements_end()) { 
     m_requesterName = readString(*val); 
   } 
+
+  val = m_wire.find(tlv::TaintedBy);
+  if (val != m_wire.elements_end()) {
+    m_taintedBy = readNonNegativeInteger(*val);
+  }
+  else {
+    m_taintedBy = 0;
+  }
  
 
   // SelectedDelegation
@@ -525,6 +537,7 @@ Interest::setTainted(const bool tainted)
     m_message_type = "tainted";
   } else if (isTainted()) {
     m_message_type = "";
+    m_taintedBy = 0;
   }
   m_wire.reset();
   return *this;
@@ -585,6 +598,10 @@ operator<<(std::ostream& os, const Interest& interest)
     os << delim << "ndn.tainted=tainted"; 
     delim = '&'; 
   }  
+  if (interest.getTaintedBy() != 0) {
+    os << delim << "ndn.taintedBy=" << interest.getTaintedBy();
+    delim = '&';
+  }
 
   return os;
 }
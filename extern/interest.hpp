@@ -440,6 +440,31 @@ public: // Selectors
   **/
   bool
   isTainted() const;
+
+  /**
+   * \brief Set the identity of the router that tainted this probe Interest
+   *
+   * Routers that receive a probe with a tainter identity other than their own forward it after the
+   * tainter, so they can still measure it.
+   *
+   * @param tainterId identity of the tainting router, 0 if unknown
+  **/
+  Interest&
+  setTaintedBy(uint64_t tainterId)
+  {
+    m_taintedBy = tainterId;
+    m_wire.reset();
+    return *this;
+  }
+
+  /**
+   * \brief Returns the identity of the router that tainted this probe Interest (0 if unknown)
+  **/
+  uint64_t
+  getTaintedBy() const
+  {
+    return m_taintedBy;
+  }
   
   /**
    * \brief Set QCI class
@@ -483,6 +508,7 @@ private:
   mutable Block m_nonce;
   time::milliseconds m_interestLifetime;
   uint32_t m_qci = 0; /**< QCI class */
+  uint64_t m_taintedBy = 0; /**< Identity of the tainting router */
 
   mutable Block m_link;
   mutable shared_ptr<Link> m_linkCached;
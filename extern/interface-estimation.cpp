@@ -20,6 +20,8 @@
 
 #include "interface-estimation.hpp"
 #include "core/logger.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace nfd {
 namespace fw {
@@ -28,39 +30,71 @@ NFD_LOG_INIT("InterfaceEstimation")
 
 InterfaceEstimation::InterfaceEstimation(
     time::milliseconds interestLifetime,
-    time::milliseconds calculationWindow): rtt(),
+    time::milliseconds calculationWindow,
+    int bandwidthBuckets,
+    double bandwidthEwmaGain): rtt(),
 loss(interestLifetime,
     calculationWindow),
-bw(calculationWindow)
+bw(calculationWindow, bandwidthBuckets, bandwidthEwmaGain),
+passiveBw(calculationWindow, bandwidthBuckets, bandwidthEwmaGain),
+m_lastRefresh(time::steady_clock::now())
 {
 }
 
-void InterfaceEstimation::addSatisfiedInterest(size_t sizeInByte, std::string name)
+void InterfaceEstimation::advance() const
 {
-  loss.addSatisfiedInterest(name);
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  if (now - m_lastRefresh < time::milliseconds(REFRESH_INTERVAL_IN_MS)) {
+    return;
+  }
+  m_lastRefresh = now;
+
+  loss.updateMeasurements();
+  bw.updateMeasurements();
+  passiveBw.updateMeasurements();
+
+  // The trends are sampled at most once per REFRESH_INTERVAL_IN_MS (their slopes are per second)
+  rttTrend.addValue(rtt.getRttInMilliseconds(), now);
+  lossTrend.addValue(loss.getLossPercentage(), now);
+}
+
+void InterfaceEstimation::addSatisfiedInterest(size_t sizeInByte, uint64_t sequence)
+{
+  advance();
+  loss.addSatisfiedInterest(sequence);
   bw.addPacket(sizeInByte);
 }
 
-void InterfaceEstimation::addSentInterest(std::string name)
+void InterfaceEstimation::addPassiveData(size_t sizeInByte)
 {
-  loss.addSentInterest(name);
+  advance();
+  passiveBw.addPacket(sizeInByte);
 }
 
-void InterfaceEstimation::removeSentInterest(std::string name)
+void InterfaceEstimation::addSentInterest(uint64_t sequence)
 {
-  loss.removeSentInterest(name);
+  advance();
+  loss.addSentInterest(sequence);
+}
+
+void InterfaceEstimation::removeSentInterest(uint64_t sequence)
+{
+  advance();
+  loss.removeSentInterest(sequence);
 }
 
 void InterfaceEstimation::addRttMeasurement(time::microseconds durationMicroSeconds)
 {
+  advance();
   rtt.addMeasurement(durationMicroSeconds);
 }
 
-double InterfaceEstimation::getCurrentValue(RequirementType type)
+double InterfaceEstimation::getCurrentValue(RequirementType type) const
 {
+  advance();
   double returnValue;
   if (type == RequirementType::BANDWIDTH) {
-    returnValue = bw.getKBytesPerSecond();
+    returnValue = std::max(bw.getKBytesPerSecond(), passiveBw.getKBytesPerSecond());
   }
   else if (type == RequirementType::DELAY) {
     if (loss.getLossPercentage() >= 1) {
@@ -80,6 +114,65 @@ double InterfaceEstimation::getCurrentValue(RequirementType type)
   return returnValue;
 }
 
+int InterfaceEstimation::getConsecutiveLosses() const
+{
+  advance();
+  return loss.getConsecutiveLosses();
+}
+
+time::steady_clock::TimePoint InterfaceEstimation::getLastUpdate() const
+{
+  advance();
+  return std::max(rtt.getLastUpdate(), std::max(loss.getLastUpdate(), bw.getLastUpdate()));
+}
+
+double InterfaceEstimation::getConfidence(time::milliseconds halfLife) const
+{
+  time::steady_clock::TimePoint lastUpdate = getLastUpdate();
+  if (lastUpdate == time::steady_clock::TimePoint::min()) {
+    return 0;
+  }
+  if (halfLife <= time::milliseconds::zero()) {
+    return 1;
+  }
+  double halfLives = time::duration_cast<time::microseconds>(time::steady_clock::now() - lastUpdate).count() /
+                     static_cast<double>(time::duration_cast<time::microseconds>(halfLife).count());
+  return std::pow(0.5, halfLives);
+}
+
+double InterfaceEstimation::getDecayedValue(RequirementType type, double prior, time::milliseconds halfLife) const
+{
+  double confidence = getConfidence(halfLife);
+  return confidence * getCurrentValue(type) + (1 - confidence) * prior;
+}
+
+double InterfaceEstimation::getTrend(RequirementType type) const
+{
+  advance();
+  if (type == RequirementType::DELAY) {
+    return rttTrend.getSlopePerSecond();
+  }
+  else if (type == RequirementType::LOSS) {
+    return lossTrend.getSlopePerSecond();
+  }
+  return 0;
+}
+
+double InterfaceEstimation::getProjectedValue(RequirementType type, time::milliseconds horizon) const
+{
+  advance();
+  if (type == RequirementType::DELAY) {
+    if (loss.getLossPercentage() >= 1) {
+      return 1000 * 1000;
+    }
+    return std::max(rttTrend.project(rtt.getRttInMilliseconds(), horizon), 0.0);
+  }
+  else if (type == RequirementType::LOSS) {
+    return std::min(std::max(lossTrend.project(loss.getLossPercentage(), horizon), 0.0), 1.0);
+  }
+  return getCurrentValue(type);
+}
+
 }
 // namespace fw
 }// namespace nfd
\ No newline at end of file
@@ -27,6 +27,7 @@
 #include <string>
 #include "loss-estimator-time-window.hpp"
 #include "rtt-estimator2.hpp"
+#include "trend-estimator.hpp"
 #include "strategy-requirements.hpp"
 #include <cstddef>
 #include "../../core/common.hpp"
@@ -36,42 +37,62 @@ namespace fw {
 
 /**
  * A class that combines all interface estimators (loss, delay & bandwidth) for easier handling.
+ *
+ * The windowed estimators are advanced lazily: every access first brings them up to date if
+ * REFRESH_INTERVAL_IN_MS has passed since the last refresh. No timer is scheduled per face and
+ * prefix, and estimators that are not accessed cost nothing.
  */
-class InterfaceEstimation
+class InterfaceEstimation : noncopyable
 {
 public:
 
   // Some constants for the interface estimators
   const static int DEFAULT_INTEREST_LIFETIME = 2000;
   const static int CALCULATION_WINDOW_IN_MS = 5000;
+  const static int REFRESH_INTERVAL_IN_MS = 1000;
 
+  /**
+   * @param interestLifetime The time after which a sent probe counts as lost.
+   * @param calculationWindow The sliding window of the loss and bandwidth estimators.
+   * @param bandwidthBuckets The number of time buckets the bandwidth window is divided into.
+   * @param bandwidthEwmaGain The gain per second of the moving average over the windowed bandwidth (0 = none).
+   */
   InterfaceEstimation(
       time::milliseconds interestLifetime = time::milliseconds(DEFAULT_INTEREST_LIFETIME),
-      time::milliseconds calculationWindow = time::milliseconds(CALCULATION_WINDOW_IN_MS));
+      time::milliseconds calculationWindow = time::milliseconds(CALCULATION_WINDOW_IN_MS),
+      int bandwidthBuckets = BandwidthEstimator::NUM_BUCKETS,
+      double bandwidthEwmaGain = 0);
 
 public:
 
   /**
    * Adds a sent interest to the loss estimator
    * 
-   * @param name The name of the Interest that should be added.
+   * @param sequence The sequence number of the Interest that should be added.
    */
-  void addSentInterest(std::string name);
+  void addSentInterest(uint64_t sequence);
 
   /**
    * Removes a sent interest from the loss estimator (e.g. if it was tainted)
    * 
-   * @param name The name of the Interest that should be removed.
+   * @param sequence The sequence number of the Interest that should be removed.
    */
-  void removeSentInterest(std::string name);
+  void removeSentInterest(uint64_t sequence);
 
   /**
    * Adds a satisfied interest to both loss and bandwidth estimators
    *
    * @param sizeInByte The size of the satisfied data packet's workload.
-   * @param name The name of the satisfied data packet
+   * @param sequence The sequence number of the satisfied data packet
+   */
+  void addSatisfiedInterest(size_t sizeInByte, uint64_t sequence);
+
+  /**
+   * Adds a data packet that was not requested by a probe (e.g. push data) to the passive bandwidth estimator
+   *
+   * @param sizeInByte The size of the data packet's workload.
    */
-  void addSatisfiedInterest(size_t sizeInByte, std::string name);
+  void addPassiveData(size_t sizeInByte);
 
   /**
    * Adds an rtt measurement to the delay estimator
@@ -81,17 +102,83 @@ public:
   void addRttMeasurement(time::microseconds durationMicroSeconds);
 
   /**
+   * Reads the running aggregates of the estimators, so it takes constant time (apart from a due refresh).
+   * Windowed values (loss and bandwidth) are brought up to date every REFRESH_INTERVAL_IN_MS.
+   * The bandwidth is the higher one of the probes and the passively measured data, since a face that
+   * delivers the workload at some rate evidently supports it.
+   *
    * @param type The type of the requirement for which the value is requested.
    * @returns the current value for the type.
    * @returns -1 if the type is invalid.
    */
-  double getCurrentValue(RequirementType type);
+  double getCurrentValue(RequirementType type) const;
+
+  /**
+   * @param type The type of the requirement (DELAY or LOSS, bandwidth has no trend).
+   * @returns the smoothed change per second of the value, sampled every REFRESH_INTERVAL_IN_MS.
+   */
+  double getTrend(RequirementType type) const;
+
+  /**
+   * Projects the current value horizon into the future along its trend (delay stays above 0,
+   * loss within [0, 1]). The projection of bandwidth is its current value.
+   *
+   * @param type The type of the requirement for which the value is requested.
+   * @param horizon How far to look ahead.
+   * @returns the projected value for the type.
+   * @returns -1 if the type is invalid.
+   */
+  double getProjectedValue(RequirementType type, time::milliseconds horizon) const;
+
+  /**
+   * @returns the number of probes that have timed out since probe data last returned on this face.
+   */
+  int getConsecutiveLosses() const;
+
+  /**
+   * @returns the time any of the estimators was last updated by a measurement,
+   *          or TimePoint::min() if there was none yet.
+   */
+  time::steady_clock::TimePoint getLastUpdate() const;
+
+  /**
+   * The confidence in the estimates halves with every halfLife that passes without a measurement.
+   *
+   * @param halfLife The half-life of the confidence (0 keeps measured estimates fully trusted).
+   * @returns the confidence in [0, 1] (0 if nothing has been measured yet).
+   */
+  double getConfidence(time::milliseconds halfLife) const;
+
+  /**
+   * Blends the current value with a prior by the confidence, so estimates that are no longer
+   * refreshed decay toward the prior instead of freezing at their last value.
+   *
+   * @param type The type of the requirement for which the value is requested.
+   * @param prior The value assumed for a face without measurements.
+   * @param halfLife The half-life of the confidence (see getConfidence()).
+   */
+  double getDecayedValue(RequirementType type, double prior, time::milliseconds halfLife) const;
 
 private:
 
+  /**
+   * Brings the windowed estimators up to date and samples the trends, if REFRESH_INTERVAL_IN_MS
+   * has passed since the last refresh. Called at the start of every access.
+   */
+  void advance() const;
+
+private:
+
+  // The windowed estimators and the trends are mutable, since reads advance them (see advance())
   RttEstimator2 rtt; // an estimator for delay
-  LossEstimatorTimeWindow loss; // an estimator for loss
-  BandwidthEstimator bw; // an estimator for bandwidth
+  mutable LossEstimatorTimeWindow loss; // an estimator for loss
+  mutable BandwidthEstimator bw; // an estimator for bandwidth (of probes)
+  mutable BandwidthEstimator passiveBw; // an estimator for bandwidth (of other data, e.g. push data)
+
+  mutable TrendEstimator rttTrend; // the trend of the delay
+  mutable TrendEstimator lossTrend; // the trend of the loss
+
+  mutable time::steady_clock::TimePoint m_lastRefresh; // the time the windowed estimators were last refreshed
 
 };
 
@@ -20,168 +20,106 @@
 
 #include "loss-estimator-time-window.hpp"
 #include "core/logger.hpp"
-#include <iostream>
-#include <chrono>
-#include <ctime>
 
 namespace nfd {
 namespace fw {
 
 NFD_LOG_INIT("LossEstimator");
 
+const int LossEstimatorTimeWindow::NUM_BUCKETS;
+
 LossEstimatorTimeWindow::LossEstimatorTimeWindow(time::steady_clock::duration interestLifetime,
     time::steady_clock::duration windowSize) :
-    m_interestLifetime(interestLifetime), m_windowSize(windowSize)
+    m_interestLifetime(interestLifetime), m_windowSize(windowSize),
+    m_buckets(windowSize, NUM_BUCKETS), m_nSatisfied(0), m_nLost(0),
+    m_nConsecutiveLost(0), m_lastUpdate(time::steady_clock::TimePoint::min())
 {
   if (m_windowSize <= m_interestLifetime) {
     throw std::runtime_error("Window size must be greater than interest lifetime!");
   }
 }
 
-void LossEstimatorTimeWindow::addSentInterest(const std::string& name)
+void LossEstimatorTimeWindow::addSentInterest(uint64_t sequence)
 {
   const time::steady_clock::TimePoint now = time::steady_clock::now();
-  auto n = unknownMap.insert(std::make_pair(name, now));
-
-  NFD_LOG_TRACE("unknownMap.insert(" << name << ")");
-
-  if (n.second == false) {
-    NFD_LOG_WARN("Duplicate insertion: " << name << " Should not happen!\n");
-    // throw std::runtime_error("Duplicate insertion of sent interest!");
+  if (!m_pending.insert(std::make_pair(sequence, now)).second) {
+    NFD_LOG_WARN("Duplicate insertion: " << sequence << " Should not happen!\n");
+    return;
   }
-
+  m_sendOrder.push_back(std::make_pair(sequence, now));
+  NFD_LOG_TRACE("Pending: " << sequence);
 }
 
-void LossEstimatorTimeWindow::removeSentInterest(const std::string& name)
+void LossEstimatorTimeWindow::removeSentInterest(uint64_t sequence)
 {
-/*  NFD_LOG_DEBUG("List before: v");
-  for (auto const& x : unknownMap)
-  {
-    std::cout << x.first  // string (key)
-              << ':' 
-              << x.second // string's value 
-              << std::endl ;
-  }*/
-  
-  int count = unknownMap.erase(name);
-  NFD_LOG_TRACE("Removed " << count << " interests from list: " << name);
-
-/*  for (auto const& x : unknownMap)
-  {
-    std::cout << x.first  // string (key)
-              << ':' 
-              << x.second // string's value 
-              << std::endl ;
-  }
-  NFD_LOG_DEBUG("List after: ^");
-  std::cout << std::endl;*/
+  int count = m_pending.erase(sequence);
+  NFD_LOG_TRACE("Removed " << count << " interests from list: " << sequence);
 }
 
-void LossEstimatorTimeWindow::addSatisfiedInterest(const std::string& name)
+void LossEstimatorTimeWindow::addSatisfiedInterest(uint64_t sequence)
 {
-  bool found = false;
-
-  for (auto n : unknownMap) {
-    // Add new data
-    if (n.first == name) {
-      NFD_LOG_TRACE("Adding found interest!: " << name);
-      found = true;
-      lossMap.insert(std::make_pair(n.second, PacketType::FUTURESATISFIED));
-      NFD_LOG_TRACE("lossMap.insert(" << n.second << ",FUTURESATISFIED)");
-      unknownMap.erase(n.first);
-      NFD_LOG_TRACE("unknownMap.erase(" << n.first << ")");
-    }
+  const time::steady_clock::TimePoint now = time::steady_clock::now();
+  m_lastUpdate = now;
+  m_nConsecutiveLost = 0;
+
+  time::steady_clock::TimePoint sendTime = now;
+  auto pending = m_pending.find(sequence);
+  if (pending != m_pending.end()) {
+    sendTime = pending->second;
+    m_pending.erase(pending);
   }
-  if (found == false) {
-    NFD_LOG_TRACE(
-        "Interest " << name
-            << " not found! Data packet returned after interest lifetime exceeded!");
-    // Still add the data packet?
-    lossMap.insert(std::make_pair(time::steady_clock::now(), PacketType::FUTURESATISFIED));
+  else {
+    // Still count the data packet (in the bucket of its arrival)
+    NFD_LOG_TRACE("Interest " << sequence << " not found! Data packet returned after interest lifetime exceeded!");
   }
-}
-
-double LossEstimatorTimeWindow::getLossPercentage()
-{
-  NFD_LOG_DEBUG("Calling updateMeasurements()");
-  // Ensure measurements are up to date before doing any calculations
-  updateMeasurements();
-
-  double perc;
 
-  // Return 0 if the map is empty
-  if (lossMap.empty()) {
-    NFD_LOG_TRACE("LossMap empty!");
-    perc = 0;
+  Counters* counters = m_buckets.find(sendTime, now);
+  if (counters != nullptr) {
+    counters->nSatisfied++;
   }
-  else {
-    int satisfied = 0;
-    int lost = 0;
-    for (auto n : lossMap) {
-      if (n.second == PacketType::SATISFIED) {
-        satisfied++;
-      }
-      if (n.second == PacketType::LOST) {
-        lost++;
-      }
-    }
+}
 
-    // Return 0 if only FUTURESATISFIED packets are in the map
-    if (lost + satisfied == 0) {
-      NFD_LOG_TRACE("Only FutureSatisfied!");
-      perc = 0;
-    }
-    else {
-      perc = (double) lost / (double) (lost + satisfied);
-    }
+double LossEstimatorTimeWindow::getLossPercentage() const
+{
+  if (m_nLost + m_nSatisfied == 0) {
+    return 0;
   }
-
-  NFD_LOG_TRACE("Loss Percentage: " << perc);
-  return perc;
+  return (double) m_nLost / (double) (m_nLost + m_nSatisfied);
 }
 
 void
 LossEstimatorTimeWindow::updateMeasurements()
 {
-  NFD_LOG_DEBUG("updateMeasurements() was called.");
-  
   const time::steady_clock::TimePoint now = time::steady_clock::now();
 
-  // Turning FUTURESATISFIED into SATISFIED (when the interest lifetime is exceeded)
-  for (auto n : lossMap) {
-    if (now > n.first + m_interestLifetime && n.second == PacketType::FUTURESATISFIED) {
-      time::steady_clock::time_point temp = n.first;
-      lossMap.erase(n.first);
-      lossMap.insert(std::make_pair(temp, PacketType::SATISFIED));
-      NFD_LOG_TRACE("Turning " << n.first << " from FUTURESATISFIED into SATISFIED (lossmap)");
-    }
-  }
-
-  // Add lost interests
-  for (auto n : unknownMap) {
-    if (now > n.second + m_interestLifetime) {
-      lossMap.insert(std::make_pair(n.second, PacketType::LOST));
-      unknownMap.erase(n.first);
-      NFD_LOG_TRACE("Interest " << n.first << " marked as LOST.");
-      NFD_LOG_TRACE("lossMap.insert(" << n.second << ",LOST.)");
+  // Add lost interests (the send order is also the order in which their lifetime is exceeded)
+  while (!m_sendOrder.empty() && now > m_sendOrder.front().second + m_interestLifetime) {
+    const std::pair<uint64_t, time::steady_clock::TimePoint>& sent = m_sendOrder.front();
+    auto pending = m_pending.find(sent.first);
+    if (pending != m_pending.end() && pending->second == sent.second) {
+      Counters* counters = m_buckets.find(sent.second, now);
+      if (counters != nullptr) {
+        counters->nLost++;
+      }
+      m_pending.erase(pending);
+      m_nConsecutiveLost++;
+      m_lastUpdate = now;
+      NFD_LOG_TRACE("Interest " << sent.first << " marked as LOST.");
     }
+    m_sendOrder.pop_front();
   }
 
-  // Remove packets that fall out of window size
-  time::steady_clock::TimePoint lastValidInterests = now - m_windowSize;
-  lossMap.erase(lossMap.begin(), lossMap.upper_bound(lastValidInterests));
+  // Count the buckets inside the window whose interests have all exceeded their lifetime
+  m_nSatisfied = 0;
+  m_nLost = 0;
+  m_buckets.forEach(now - m_windowSize, now - m_interestLifetime - m_buckets.getBucketWidth(),
+                    [this] (const Counters& counters) {
+                      m_nSatisfied += counters.nSatisfied;
+                      m_nLost += counters.nLost;
+                    });
 
-  // Set timer to ensure this method is called periodically
-  setRefreshTimer();
-}
-
-void
-LossEstimatorTimeWindow::setRefreshTimer()
-{
-time::nanoseconds refreshTime = time::milliseconds(1000); // 1 second
-  scheduler::cancel(m_refreshTimer);
-  m_refreshTimer = scheduler::schedule(refreshTime, bind(&LossEstimatorTimeWindow::updateMeasurements, this));
+  NFD_LOG_TRACE("Loss Percentage: " << getLossPercentage());
 }
 
 }  // namespace fw
-}  // namespace nfd
\ No newline at end of file
+}  // namespace nfd
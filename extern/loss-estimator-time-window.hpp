@@ -23,7 +23,9 @@
 
 #include "common.hpp"
 #include "loss-estimator.hpp"
-#include "core/scheduler.hpp"
+#include "time-bucket-window.hpp"
+#include <deque>
+#include <unordered_map>
 
 namespace nfd {
 namespace fw {
@@ -32,6 +34,10 @@ namespace fw {
  * Implements the loss estimation with a sliding window over the last x time units.
  * The loss percentage is calculated with all packets of status LOST or SATISFIED during the
  * sliding window.
+ *
+ * Pending Interests are kept in a hash index (plus a queue in send order to find the ones whose
+ * lifetime is exceeded), and resolved packets are counted in a ring of NUM_BUCKETS time buckets
+ * that covers the window, so sending, satisfying, removing and reading are all O(1).
  */
 class LossEstimatorTimeWindow : public LossEstimator
 {
@@ -50,54 +56,77 @@ public:
       time::steady_clock::duration lossWindow);
 
   /**
-   * Adds an interest to the unknownMap.
+   * Adds a pending interest.
    *
-   * @param name The name of the Interest that should be added.
-   * @throws runtime-exception if the name already exists.(currently disabled)
+   * @param sequence The sequence number of the Interest that should be added.
+   * @note A sequence number that is already pending keeps its first send time.
    */
-  void addSentInterest(const std::string& name);
+  void addSentInterest(uint64_t sequence);
 
   /**
-   * Removes an interest from the unknownMap.
+   * Removes a pending interest (it is neither counted as satisfied nor as lost).
    *
-   * @param name The name of the Interest that should be removed.
+   * @param sequence The sequence number of the Interest that should be removed.
    */
-  void removeSentInterest(const std::string& name);
+  void removeSentInterest(uint64_t sequence);
 
   /**
    * Adds a satisfied interest packet.
    *
-   * @param name The name of the Interest that should treated as satisfied.
+   * @param sequence The sequence number of the Interest that should treated as satisfied.
    */
-  void addSatisfiedInterest(const std::string& name);
+  void addSatisfiedInterest(uint64_t sequence);
 
   /**
+   * Computed in constant time from the running counters, as of the last call of updateMeasurements().
+   *
    * @returns the loss percentage.
-   * @returns 0 if the lossMap is empty or contains only FUTURESATISFIED packets.
+   * @returns 0 if no packet in the window has been resolved yet.
+   */
+  double getLossPercentage() const;
+
+  /**
+   * @returns the time a packet was last resolved (its data returned or it was marked LOST),
+   *          or TimePoint::min() if there was none yet.
    */
-  double getLossPercentage();
+  time::steady_clock::TimePoint getLastUpdate() const
+  {
+    return m_lastUpdate;
+  }
 
   /**
-   * Brings all the lists up to date to ensure correct measurements
+   * @returns the number of interests marked LOST since data last returned, as of the last call of
+   *          updateMeasurements(). A face that drops everything (without Nacks) keeps raising it.
+   */
+  int getConsecutiveLosses() const
+  {
+    return m_nConsecutiveLost;
+  }
+
+  /**
+   * Marks the pending interests whose lifetime is exceeded as LOST and recounts the buckets inside
+   * the window. Called by InterfaceEstimation::advance() at most once per REFRESH_INTERVAL_IN_MS.
    */
   void updateMeasurements();
 
+public:
+
   /**
-   * Sets a timer which will call updateMeasurements() after it times out.
+   * The number of time buckets the window is divided into.
    */
-  void setRefreshTimer();
+  static const int NUM_BUCKETS = 50;
 
 private:
 
   /**
-   * Packet types:
-   * - SATISFIED: A data packet has returned for that interest.
-   * - LOST: No data packet has returned and the interest lifetime is exceeded
-   * - FUTURESATISFIED: No data packet has returned, but may return in the future (the interest lifetime is not exceeded yet)
+   * The packets sent during one bucket width that have been resolved so far.
+   * A bucket is only counted once the lifetime of all its interests is exceeded, so
+   * satisfied packets do not outweigh the lost ones that are not known yet.
    */
-  enum class PacketType
+  struct Counters
   {
-    SATISFIED, LOST, FUTURESATISFIED
+    int nSatisfied;
+    int nLost;
   };
 
 private:
@@ -113,20 +142,34 @@ private:
   const time::steady_clock::duration m_windowSize;
 
   /**
-   * A timer to ensure the measurements are kept up to date periodically.
+   * The send times of the interests inside the interest lifetime.
+   * Their status is undecided depending on wheter a data packet will return.
    */
-  scheduler::EventId m_refreshTimer;
+  std::unordered_map<uint64_t, time::steady_clock::TimePoint> m_pending;
 
   /**
-   * The map for interests inside the interest lifetime.
-   * Their status is undecided depending on wheter a data packet will return.
+   * The pending interests in the order they were sent (entries that were satisfied or removed
+   * in the meantime are skipped when they reach the front).
+   */
+  std::deque<std::pair<uint64_t, time::steady_clock::TimePoint>> m_sendOrder;
+
+  /**
+   * The resolved packets by send time.
    */
-  std::map<const std::string, const time::steady_clock::TimePoint> unknownMap;
+  TimeBucketWindow<Counters> m_buckets;
 
   /**
-   * The map for the final loss calculation.
+   * The number of SATISFIED and LOST packets in the counted buckets.
    */
-  std::map<const time::steady_clock::TimePoint, const PacketType> lossMap;
+  int m_nSatisfied;
+  int m_nLost;
+
+  /**
+   * The number of interests marked LOST since the last satisfied one.
+   */
+  int m_nConsecutiveLost;
+
+  time::steady_clock::TimePoint m_lastUpdate;
 
 };
 
@@ -134,4 +177,3 @@ private:
 }  // namespace nfd
 
 #endif // NFD_DAEMON_FW_LOSS_ESTIMATOR_HPP
-
@@ -40,17 +40,17 @@ public:
   /**
    * Adds one sent interest packet
    */
-  virtual void addSentInterest(const std::string& name) = 0;
+  virtual void addSentInterest(uint64_t sequence) = 0;
 
   /**
    * Adds one satisfied interest packet (= received data packet)
    */
-  virtual void addSatisfiedInterest(const std::string& name) = 0;
+  virtual void addSatisfiedInterest(uint64_t sequence) = 0;
 
   /**
    * Returns the loss percentage as value between 0 and 1.
    */
-  virtual double getLossPercentage() = 0;
+  virtual double getLossPercentage() const = 0;
 
 };
 
@@ -22,9 +22,11 @@
 
 #include "strategy-info.hpp"
 #include "strategy-requirements.hpp"
+#include <tuple>
 #include <unordered_map>
 #include "../face/face.hpp"
 #include "interface-estimation.hpp"
+#include "tainted-probe-set.hpp"
 
 namespace nfd {
 namespace fw {
@@ -45,15 +47,29 @@ public:
   {
   }
 
+  /**
+   * Returns the measurements of a face and creates them with the given bandwidth estimator settings
+   * (BANDWIDTH_BUCKETS and BANDWIDTH_EWMA_GAIN of the prefix) if the face has none yet.
+   */
+  InterfaceEstimation& getOrCreateFaceInfo(FaceId faceId, int bandwidthBuckets, double bandwidthEwmaGain)
+  {
+    auto it = faceInfoMap.find(faceId);
+    if (it == faceInfoMap.end())
+    {
+      it = faceInfoMap.emplace(std::piecewise_construct, std::forward_as_tuple(faceId),
+                               std::forward_as_tuple(time::milliseconds(InterfaceEstimation::DEFAULT_INTEREST_LIFETIME),
+                                                     time::milliseconds(InterfaceEstimation::CALCULATION_WINDOW_IN_MS),
+                                                     bandwidthBuckets, bandwidthEwmaGain)).first;
+    }
+    return it->second;
+  }
+
 public:
   // A map containing per-face measurements
   std::unordered_map<FaceId, InterfaceEstimation> faceInfoMap;
 
-  // A map where timestamps of sent Interests are saved for RTT measurement.
-  std::unordered_map<std::string, time::steady_clock::TimePoint> rttTimeMap;
-
-  // A set containing the names of all the probes that have been redirected (tainted) by this router.
-  std::set<std::string> myTaintedProbes;
+  // The sequence numbers of the probes that have been redirected (tainted) by this router and are still pending.
+  TaintedProbeSet myTaintedProbes;
 
   // An object which can hold all the hard limits required for this strategy.
   StrategyRequirements req;
@@ -0,0 +1,50 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NFD_DAEMON_FW_OUT_RECORD_INFO_HPP
+#define NFD_DAEMON_FW_OUT_RECORD_INFO_HPP
+
+#include "strategy-info.hpp"
+
+namespace nfd {
+namespace fw {
+
+/**
+ * Information attached to a PIT out-record by the forwarder when the Interest is sent.
+ *
+ * Strategies can compute the RTT of the upstream that answered from the matching out-record,
+ * which also stays correct if the Interest has been sent on several faces.
+ */
+class OutRecordInfo : public StrategyInfo
+{
+public:
+  static constexpr int getTypeId()
+  {
+    return 1013;
+  }
+
+public:
+  // The time the Interest was last sent on the face of this out-record.
+  time::steady_clock::TimePoint sendTime;
+};
+
+}  //fw
+}  //nfd
+
+#endif
@@ -24,7 +24,8 @@ namespace nfd {
 namespace fw {
 
 RttEstimator2::RttEstimator2(time::microseconds initialRtt, double gain) :
-    rttInMicroSec(initialRtt.count()), gain(gain), sampleCount(0)
+    rttInMicroSec(initialRtt.count()), gain(gain), sampleCount(0),
+    lastUpdate(time::steady_clock::TimePoint::min())
 {
 }
 
@@ -40,6 +41,7 @@ void RttEstimator2::addMeasurement(time::microseconds measure)
     rttInMicroSec = m;
   }
   sampleCount++;
+  lastUpdate = time::steady_clock::now();
 }
 
 double RttEstimator2::getRttInMilliseconds() const
@@ -54,11 +54,21 @@ public:
   double
   getRttInMilliseconds() const;
 
+  /**
+   * @returns the time of the last measurement, or TimePoint::min() if there was none yet.
+   */
+  time::steady_clock::TimePoint
+  getLastUpdate() const
+  {
+    return lastUpdate;
+  }
+
 private:
 
   double rttInMicroSec;
   double gain;
   uint32_t sampleCount;
+  time::steady_clock::TimePoint lastUpdate;
 };
 
 }  // namespace fw
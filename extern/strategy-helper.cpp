@@ -79,31 +79,65 @@ bool StrategyHelper::probingDue()
   }
 }
 
-std::tuple<Name, shared_ptr<MeasurementInfo>> StrategyHelper::findPrefixMeasurements(
-    const Interest& interest, const MeasurementsAccessor& measurements)
+measurements::Entry* StrategyHelper::addPrefixMeasurements(const Name& name, size_t prefixLength,
+    MeasurementsAccessor& measurements)
 {
-  shared_ptr < measurements::Entry > me = shared_ptr < measurements::Entry >(measurements.findLongestPrefixMatch(interest.getName()));
+  measurements::Entry* me = nullptr;
+  if (name.size() >= prefixLength) {
+    // Save info at the prefix.
+    me = measurements.get(name.getPrefix(prefixLength));
+  }
+  // prefix of the Name is not in this strategy, or Name is shorter than the prefix
   if (me == nullptr) {
-    return std::forward_as_tuple(Name(), nullptr);
+    me = measurements.get(name);
   }
-  shared_ptr < MeasurementInfo > mi = shared_ptr < MeasurementInfo >(me->getStrategyInfo<MeasurementInfo>());
-  return std::forward_as_tuple(me->getName(), mi);
+
+  return me;
 }
 
-shared_ptr<MeasurementInfo> StrategyHelper::addPrefixMeasurements(const Interest& interest,
-    MeasurementsAccessor& measurements)
+size_t StrategyHelper::hashPrefix(const Name& name, size_t prefixLength)
 {
-  shared_ptr < measurements::Entry > me;
-  if (interest.getName().size() >= 1) {
-    // Save info one step up.
-    me = shared_ptr < measurements::Entry >(measurements.get(interest.getName().getPrefix(-1)));
+  // FNV-1a over the TLV-TYPE, TLV-LENGTH and TLV-VALUE of each component
+  uint64_t hash = 14695981039346656037ULL;
+  auto mix = [&hash] (uint64_t value) {
+    hash ^= value;
+    hash *= 1099511628211ULL;
+  };
+
+  for (size_t i = 0; i < prefixLength; ++i)
+  {
+    const name::Component& component = name.get(i);
+    mix(component.type());
+    mix(component.value_size());
+    const uint8_t* value = component.value();
+    for (size_t j = 0; j < component.value_size(); ++j)
+    {
+      mix(value[j]);
+    }
   }
-  // parent of Interest Name is not in this strategy, or Interest Name is empty
-  if (me == nullptr) {
-    me = shared_ptr < measurements::Entry >(measurements.get(interest.getName()));
+  return static_cast<size_t>(hash);
+}
+
+uint64_t StrategyHelper::getProbeSequence(const Name& name)
+{
+  const name::Component& last = name.get(-1);
+  if (last.isSequenceNumber())
+  {
+    return last.toSequenceNumber();
   }
+  return hashPrefix(name, name.size());
+}
+
+uint64_t StrategyHelper::allocateTainterId()
+{
+  static uint64_t lastTainterId = 0;
+  return ++lastTainterId;
+}
 
-  return shared_ptr < MeasurementInfo >(me->insertStrategyInfo<MeasurementInfo>().first);
+bool StrategyHelper::isTaintedBefore(const pit::Entry& pitEntry, uint64_t tainterId)
+{
+  const Interest& interest = pitEntry.getInterest();
+  return interest.isTainted() && interest.getTaintedBy() != 0 && interest.getTaintedBy() != tainterId;
 }
 
 }  // namespace nfd
@@ -23,8 +23,8 @@
 
 #include <map>
 #include <string>
-#include <tuple>
 #include "../table/measurements-accessor.hpp"
+#include "../table/pit-entry.hpp"
 #include "measurement-info.hpp"
 
 namespace nfd {
@@ -45,17 +45,52 @@ public:
   static std::map<std::string, std::string> getParameterMap(std::string parameterString);
 
   /**
-   * Finds a measurement for the given interest name in a longest prefix match.
+   * Finds the measurements entry that holds strategy info of type T for the given pit entry
+   * in a longest prefix match.
+   *
+   * \returns nullptr if no such entry exists.
    */
-  static std::tuple<Name, shared_ptr<MeasurementInfo>> findPrefixMeasurements(
-      const Interest& interest, const MeasurementsAccessor& measurements);
+  template<typename T>
+  static measurements::Entry* findPrefixMeasurements(const pit::Entry& pitEntry,
+      const MeasurementsAccessor& measurements)
+  {
+    return measurements.findLongestPrefixMatch(pitEntry, measurements::EntryWithStrategyInfo<T>());
+  }
 
   /**
-   * Adds a prefix measurement one level upwards of the interest name.
+   * Adds (or gets) the measurements entry for the first prefixLength components of the name.
+   * Falls back to the full name if the prefix is not in the namespace of the calling strategy.
    */
-  static shared_ptr<MeasurementInfo> addPrefixMeasurements(const Interest& interest,
+  static measurements::Entry* addPrefixMeasurements(const Name& name, size_t prefixLength,
       MeasurementsAccessor& measurements);
 
+  /**
+   * Extracts the key used for probe bookkeeping (loss, RTT and tainting) from a probe name.
+   *
+   * \returns the sequence number in the last component, or a hash of the whole name if the
+   *          probe has no sequence number component.
+   */
+  static uint64_t getProbeSequence(const Name& name);
+
+  /**
+   * Hashes the first prefixLength components of a name (type and value of each component).
+   */
+  static size_t hashPrefix(const Name& name, size_t prefixLength);
+
+  /**
+   * Allocates a new identity for a router that taints probes (unique within the process, never 0).
+   */
+  static uint64_t allocateTainterId();
+
+  /**
+   * Checks whether the probe of a pit entry arrived here already tainted by another router.
+   * This router then forwards the probe after the tainter, so its Data is a valid sample for
+   * the face the probe was sent on.
+   *
+   * \param tainterId the identity this router uses for tainting
+   */
+  static bool isTaintedBefore(const pit::Entry& pitEntry, uint64_t tainterId);
+
   /**
    * Performs probing every x th packet.
    *
@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "tainted-probe-set.hpp"
+#include <algorithm>
+
+namespace nfd {
+namespace fw {
+
+const size_t TaintedProbeSet::DEFAULT_CAPACITY;
+
+TaintedProbeSet::TaintedProbeSet(size_t capacity) :
+    entries(std::max<size_t>(capacity, 1), Entry{0, time::steady_clock::TimePoint::min()}), next(0), evictions(0)
+{
+}
+
+void TaintedProbeSet::insert(uint64_t sequence, time::steady_clock::TimePoint now, time::milliseconds lifetime)
+{
+  Entry& entry = entries[next];
+  if (entry.expiry > now) {
+    ++evictions;
+  }
+  entry.sequence = sequence;
+  entry.expiry = now + lifetime;
+  next = (next + 1) % entries.size();
+}
+
+bool TaintedProbeSet::contains(uint64_t sequence, time::steady_clock::TimePoint now) const
+{
+  for (const Entry& entry : entries) {
+    if (entry.sequence == sequence && entry.expiry > now) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool TaintedProbeSet::erase(uint64_t sequence, time::steady_clock::TimePoint now)
+{
+  bool wasMember = false;
+  for (Entry& entry : entries) {
+    if (entry.sequence == sequence && entry.expiry > now) {
+      entry.expiry = time::steady_clock::TimePoint::min();
+      wasMember = true;
+    }
+  }
+  return wasMember;
+}
+
+}  // namespace fw
+}  // namespace nfd
@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NFD_DAEMON_FW_TAINTED_PROBE_SET_HPP
+#define NFD_DAEMON_FW_TAINTED_PROBE_SET_HPP
+
+#include "common.hpp"
+#include <vector>
+
+namespace nfd {
+namespace fw {
+
+/**
+ * Remembers the sequence numbers of the probes a router has tainted until their Data comes back.
+ * The set has a fixed capacity and every entry expires (e.g. after the lifetime of the Interest),
+ * so probes that are lost do not accumulate. Entries are kept in a ring in the order they were
+ * inserted, which is also the order of their expiry, and a full ring overwrites its oldest entry.
+ */
+class TaintedProbeSet
+{
+public:
+
+  explicit
+  TaintedProbeSet(size_t capacity = DEFAULT_CAPACITY);
+
+  /**
+   * Adds a probe that stays a member for lifetime (or until it is erased).
+   */
+  void
+  insert(uint64_t sequence, time::steady_clock::TimePoint now, time::milliseconds lifetime);
+
+  /**
+   * @returns true if the probe is a member that has not expired yet.
+   */
+  bool
+  contains(uint64_t sequence, time::steady_clock::TimePoint now) const;
+
+  /**
+   * Removes a probe.
+   *
+   * @returns true if the probe was a member that had not expired yet.
+   */
+  bool
+  erase(uint64_t sequence, time::steady_clock::TimePoint now);
+
+  /**
+   * @returns the number of members that were overwritten before they expired (because the set was full).
+   */
+  uint64_t
+  getEvictions() const
+  {
+    return evictions;
+  }
+
+  /**
+   * @returns the memory held by the set in bytes (constant, since the capacity is fixed).
+   */
+  size_t
+  getMemoryUsage() const
+  {
+    return sizeof(*this) + entries.capacity() * sizeof(Entry);
+  }
+
+public:
+
+  static const size_t DEFAULT_CAPACITY = 64;
+
+private:
+
+  struct Entry
+  {
+    uint64_t sequence;
+    time::steady_clock::TimePoint expiry;
+  };
+
+  std::vector<Entry> entries;
+  size_t next;
+  uint64_t evictions;
+};
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif
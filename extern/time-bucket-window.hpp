@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NFD_DAEMON_FW_TIME_BUCKET_WINDOW_HPP
+#define NFD_DAEMON_FW_TIME_BUCKET_WINDOW_HPP
+
+#include "common.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace nfd {
+namespace fw {
+
+/**
+ * A sliding window divided into fixed-width time buckets, each holding a set of counters.
+ * The buckets form a ring that covers the window, so packets with identical timestamps are all
+ * counted, nothing is allocated per packet and the memory is constant.
+ *
+ * @tparam Counters The counters of one bucket (value-initialized when a bucket is (re)used).
+ */
+template<typename Counters>
+class TimeBucketWindow
+{
+public:
+
+  /**
+   * @param window The time covered by the window.
+   * @param nBuckets The number of buckets the window is divided into (its resolution).
+   */
+  TimeBucketWindow(time::steady_clock::duration window, int nBuckets) :
+      bucketWidth(std::max<int64_t>(time::duration_cast<time::nanoseconds>(window).count() / std::max(nBuckets, 1), 1)),
+      buckets(std::max(nBuckets, 1) + 1, Bucket{NO_INDEX, Counters()}),
+      expiredIndex(NO_INDEX)
+  {
+  }
+
+  /**
+   * @returns the counters of the bucket covering timePoint, or nullptr if timePoint has
+   *          already left the window at now.
+   */
+  Counters*
+  find(time::steady_clock::TimePoint timePoint, time::steady_clock::TimePoint now)
+  {
+    const int64_t index = getIndex(timePoint);
+    const int64_t size = buckets.size();
+    if (index <= getIndex(now) - size) {
+      return nullptr;
+    }
+    Bucket& bucket = buckets[((index % size) + size) % size];
+    if (bucket.index != index) {
+      bucket.index = index;
+      bucket.counters = Counters();
+    }
+    return &bucket.counters;
+  }
+
+  /**
+   * Calls function with the counters of every bucket between the buckets covering first and last (inclusive).
+   */
+  template<typename Function>
+  void
+  forEach(time::steady_clock::TimePoint first, time::steady_clock::TimePoint last, Function function) const
+  {
+    const int64_t firstIndex = getIndex(first);
+    const int64_t lastIndex = getIndex(last);
+    for (const Bucket& bucket : buckets) {
+      if (bucket.index >= firstIndex && bucket.index <= lastIndex) {
+        function(bucket.counters);
+      }
+    }
+  }
+
+  /**
+   * Calls function once with the counters of every bucket that has left the window at now, i.e. is
+   * older than the last nBuckets buckets (the one covering now included), and clears them.
+   * Takes time proportional to the buckets that have passed since the last call (at most nBuckets + 1).
+   */
+  template<typename Function>
+  void
+  expire(time::steady_clock::TimePoint now, Function function)
+  {
+    const int64_t size = buckets.size();
+    const int64_t lastExpired = getIndex(now) - (size - 1);
+    if (lastExpired <= expiredIndex) {
+      return;
+    }
+    // The ring slots of the indexes up to lastExpired that have not been visited yet
+    const int64_t first = (expiredIndex == NO_INDEX) ? lastExpired - size + 1
+                                                     : std::max(expiredIndex + 1, lastExpired - size + 1);
+    for (int64_t index = first; index <= lastExpired; index++) {
+      Bucket& bucket = buckets[((index % size) + size) % size];
+      if (bucket.index != NO_INDEX && bucket.index <= lastExpired) {
+        function(bucket.counters);
+        bucket.index = NO_INDEX;
+        bucket.counters = Counters();
+      }
+    }
+    expiredIndex = lastExpired;
+  }
+
+  /**
+   * @returns the time covered by one bucket.
+   */
+  time::nanoseconds
+  getBucketWidth() const
+  {
+    return time::nanoseconds(bucketWidth);
+  }
+
+private:
+
+  int64_t
+  getIndex(time::steady_clock::TimePoint timePoint) const
+  {
+    int64_t ns = time::duration_cast<time::nanoseconds>(timePoint.time_since_epoch()).count();
+    int64_t index = ns / bucketWidth;
+    return (ns % bucketWidth < 0) ? index - 1 : index;
+  }
+
+private:
+
+  struct Bucket
+  {
+    int64_t index;
+    Counters counters;
+  };
+
+  // The index of a bucket that is not in use
+  static constexpr int64_t NO_INDEX = std::numeric_limits<int64_t>::min();
+
+  // The width of one bucket in nanoseconds
+  const int64_t bucketWidth;
+
+  // The ring of buckets (one more than the window needs, for the bucket that is only partly inside)
+  std::vector<Bucket> buckets;
+
+  // The newest index up to which expire() has cleared the buckets
+  int64_t expiredIndex;
+};
+
+template<typename Counters>
+constexpr int64_t TimeBucketWindow<Counters>::NO_INDEX;
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif // NFD_DAEMON_FW_TIME_BUCKET_WINDOW_HPP
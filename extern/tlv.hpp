@@ -90,6 +90,7 @@ enum {
   MessageType = 33, 
   RequesterName = 34, 
   QCI = 35, 
+  TaintedBy = 36,
 
   AppPrivateBlock1 = 128,
   AppPrivateBlock2 = 32767
@@ -0,0 +1,43 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "trend-estimator.hpp"
+
+namespace nfd {
+namespace fw {
+
+TrendEstimator::TrendEstimator(double gain) :
+    gain(gain), slopePerSecond(0), lastValue(0), hasValue(false)
+{
+}
+
+void TrendEstimator::addValue(double value, time::steady_clock::TimePoint now)
+{
+  if (hasValue && now > lastTime) {
+    double seconds = time::duration_cast<time::microseconds>(now - lastTime).count() / 1000000.0;
+    double slope = (value - lastValue) / seconds;
+    slopePerSecond += (slope - slopePerSecond) * gain;
+  }
+  lastValue = value;
+  lastTime = now;
+  hasValue = true;
+}
+
+}  // namespace fw
+}  // namespace nfd
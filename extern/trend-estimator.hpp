@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NFD_DAEMON_FW_TREND_ESTIMATOR_HPP
+#define NFD_DAEMON_FW_TREND_ESTIMATOR_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+namespace fw {
+
+/**
+ * Estimates the short-term trend of a measured value as an exponential moving average of the slope
+ * between consecutive values. Values should be added at a steady pace (e.g. on a refresh timer),
+ * since slopes between samples that are very close in time are dominated by noise.
+ */
+class TrendEstimator
+{
+public:
+
+  /**
+   * @param gain The alpha/gain factor of the exponential moving average of the slope.
+   */
+  explicit
+  TrendEstimator(double gain = 0.3);
+
+  /**
+   * Adds the current value of the measured quantity.
+   */
+  void
+  addValue(double value, time::steady_clock::TimePoint now);
+
+  /**
+   * @returns the smoothed change of the value per second (0 until two values have been added).
+   */
+  double
+  getSlopePerSecond() const
+  {
+    return slopePerSecond;
+  }
+
+  /**
+   * @returns the value projected horizon into the future along the current trend.
+   */
+  double
+  project(double value, time::milliseconds horizon) const
+  {
+    return value + slopePerSecond * horizon.count() / 1000.0;
+  }
+
+private:
+
+  double gain;
+  double slopePerSecond;
+  double lastValue;
+  time::steady_clock::TimePoint lastTime;
+  bool hasValue;
+};
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif
@@ -48,11 +48,16 @@ else:
 
 class SimulationJob (workerpool.Job):
     "Job to simulate things"
-    def __init__ (self, cmdline):
+    def __init__ (self, cmdline, output=None):
         self.cmdline = cmdline
+        self.output = output
     def run (self):
         print (" ".join (self.cmdline))
-        subprocess.call (self.cmdline)
+        if self.output is None:
+            subprocess.call (self.cmdline)
+        else:
+            with open (self.output, "w") as output:
+                subprocess.call (self.cmdline, stdout=output)
 
 pool = workerpool.WorkerPool(size = multiprocessing.cpu_count())
 
@@ -92,11 +97,70 @@ class Scenario (Processor):
         # any postprocessing, if any
         pass
 
+class PathSelectionComparison (Processor):
+    "Runs scenario variants and compares their PathSelection reports"
+    def __init__ (self, name, runs):
+        self.name = name
+        self.runs = runs # list of (scenario, label, arguments)
+        self.resultDir = "results/%s" % name
+
+    def output (self, scenario, label):
+        return "%s/%s-%s.txt" % (self.resultDir, scenario, label)
+
+    def simulate (self):
+        if not os.path.exists (self.resultDir):
+            os.makedirs (self.resultDir)
+        for scenario, label, arguments in self.runs:
+            cmdline = ["./build/%s" % scenario] + arguments
+            if scenario == "PIPS-scenario":
+                cmdline.append ("--logDir=%s/%s-%s-" % (self.resultDir, scenario, label))
+            pool.put (SimulationJob (cmdline, self.output (scenario, label)))
+
+    def postprocess (self):
+        lines = ["%-22s %-24s %-10s %-14s %-20s %-9s %-11s %-18s %-16s %-11s %s" % ("scenario", "variant", "probes", "probeOverhead",
+                 "absorbedBytesPerProbe", "switches", "violations", "violationTimeMs", "meanViolationMs", "recoveries",
+                 "meanRecoveryTimeMs")]
+        for scenario, label, arguments in self.runs:
+            total = {"probes": 0, "explorationProbes": 0, "absorbedProbeBytes": 0, "switches": 0, "violations": 0,
+                     "violationTimeMs": 0.0, "recoveries": 0, "recoveryTimeMs": 0.0}
+            if not os.path.exists (self.output (scenario, label)):
+                continue
+            for line in open (self.output (scenario, label)):
+                if not line.startswith ("PathSelection "):
+                    continue
+                values = dict (field.split ("=", 1) for field in line.split ()[1:])
+                for key in total:
+                    total[key] += float (values[key])
+            overhead = total["explorationProbes"] / total["probes"] if total["probes"] > 0 else 0
+            absorbed = total["absorbedProbeBytes"] / total["explorationProbes"] if total["explorationProbes"] > 0 else 0
+            meanViolation = total["violationTimeMs"] / total["violations"] if total["violations"] > 0 else 0
+            recovery = total["recoveryTimeMs"] / total["recoveries"] if total["recoveries"] > 0 else 0
+            lines.append ("%-22s %-24s %-10d %-14.4f %-20.1f %-9d %-11d %-18.1f %-16.1f %-11d %.1f" % (scenario, label, total["probes"],
+                          overhead, absorbed, total["switches"], total["violations"], total["violationTimeMs"], meanViolation,
+                          total["recoveries"], recovery))
+        with open ("%s/summary.txt" % self.resultDir, "w") as summary:
+            summary.write ("\n".join (lines) + "\n")
+        print "\n".join (lines)
+
+    def graph (self):
+        # the comparison is a table (see postprocess), there is nothing to plot
+        pass
+
 try:
     # Simulation, processing, and graph building
     fig = Scenario (name="NAME_TO_CONFIGURE")
     fig.run ()
 
+    comparison = PathSelectionComparison (name="strategy-comparison", runs=[
+        (scenario, strategy, ["--forwardingStrategy=%s" % strategy])
+        for scenario in ["PIPS-scenario", "PIPS-scenario-simple"] for strategy in ["lowest-cost", "bandit"]])
+    comparison.run ()
+
+    predictive = PathSelectionComparison (name="predictive-switching", runs=[
+        (scenario, "horizon-%dms" % horizon, ["--forwardingStrategy=lowest-cost", "--predictiveHorizon=%d" % horizon])
+        for scenario in ["PIPS-scenario", "PIPS-scenario-simple"] for horizon in [0, 1000, 2000, 4000]])
+    predictive.run ()
+
 finally:
     pool.join ()
     pool.shutdown ()
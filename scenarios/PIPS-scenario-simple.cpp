@@ -23,6 +23,7 @@
 #include "ns3/ndnSIM/helper/ndn-link-control-helper.hpp"
 #include "../extensions/utils/parameterconfiguration.h"
 #include "../extensions/strategies/lowest-cost-strategy.hpp"
+#include "../extensions/strategies/path-selection-stats.hpp"
 
 using ns3::ndn::StrategyChoiceHelper;
 
@@ -31,7 +32,13 @@ namespace ns3 {
 int
 main(int argc, char* argv[])
 {
+  // Choosing a forwarding strategy
+  std::string strategy = "lowest-cost";
+  int predictiveHorizon = 0;
+
   CommandLine cmd;
+  cmd.AddValue("forwardingStrategy", "Used forwarding strategy on all nodes (lowest-cost|bandit)", strategy);
+  cmd.AddValue("predictiveHorizon", "Time in milliseconds ahead a delay or loss trend may not cross the limits (0 disables it)", predictiveHorizon);
   cmd.Parse(argc, argv);
 
   // Defining main prefixes
@@ -51,6 +58,7 @@ main(int argc, char* argv[])
   ParameterConfiguration::getInstance()->setParameter("REQUIREMENT_MAXLOSS", 0.1, prefix1);
   ParameterConfiguration::getInstance()->setParameter("REQUIREMENT_MINBANDWIDTH", 0.0, prefix1);
   ParameterConfiguration::getInstance()->setParameter("RTT_TIME_TABLE_MAX_DURATION", 1000, prefix1);
+  ParameterConfiguration::getInstance()->setParameter("PREDICTIVE_HORIZON", predictiveHorizon, prefix1);
 
   ParameterConfiguration::getInstance()->setParameter("TAINTING_ENABLED", 1, prefix2);
   ParameterConfiguration::getInstance()->setParameter("MIN_NUM_OF_FACES_FOR_TAINTING", 3, prefix2);
@@ -59,6 +67,7 @@ main(int argc, char* argv[])
   ParameterConfiguration::getInstance()->setParameter("REQUIREMENT_MAXLOSS", 0.1, prefix2);
   ParameterConfiguration::getInstance()->setParameter("REQUIREMENT_MINBANDWIDTH", 0.0, prefix2);
   ParameterConfiguration::getInstance()->setParameter("RTT_TIME_TABLE_MAX_DURATION", 1000, prefix2);
+  ParameterConfiguration::getInstance()->setParameter("PREDICTIVE_HORIZON", predictiveHorizon, prefix2);
 
   AnnotatedTopologyReader topologyReader("", 25);
   topologyReader.SetFileName("scenarios/topologies/lowest-cost-topology.txt");
@@ -95,9 +104,6 @@ main(int argc, char* argv[])
   nodesWithNewStrat.Add(Names::Find<Node>("Prod2"));
 
 
-  // Choosing a forwarding strategy
-  std::string strategy = "lowest-cost";
-
   ndn::StrategyChoiceHelper::Install(nodesWithNewStrat, prefix1,
     "/localhost/nfd/strategy/" + strategy + "/%FD%01/");
   ndn::StrategyChoiceHelper::Install(nodesWithNewStrat, prefix2,
@@ -175,6 +181,16 @@ main(int argc, char* argv[])
   Simulator::Stop(Seconds(60.0));
 
   Simulator::Run();
+
+  // Report the path selection of every node (probe overhead, switches and requirement violations)
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); ++node) {
+    nfd::fw::Strategy& effectiveStrategy = (*node)->GetObject<ndn::L3Protocol>()->getForwarder()
+                                    ->getStrategyChoice().findEffectiveStrategy(prefix1);
+    nfd::fw::PathSelectionReporter* reporter = dynamic_cast<nfd::fw::PathSelectionReporter*>(&effectiveStrategy);
+    if (reporter != nullptr) {
+      reporter->printPathSelectionStats(std::cout, "PathSelection node=" + Names::FindName(*node));
+    }
+  }
   Simulator::Destroy();
 
   return 0;
@@ -23,6 +23,7 @@
 #include "ns3/ndnSIM/helper/ndn-link-control-helper.hpp"
 #include "../extensions/utils/parameterconfiguration.h"
 #include "../extensions/strategies/lowest-cost-strategy.hpp"
+#include "../extensions/strategies/path-selection-stats.hpp"
 
 #include "../extensions/tracers/push-tracer.hpp"
 #include "../extensions/tracers/ndn-l3-packet-tracer.hpp"
@@ -56,6 +57,16 @@ main(int argc, char* argv[])
   double requirementMaxLoss = 0.2;
   double requirementMinBandwidth = 0.0;
   int rttTimeTableMaxDuration = 1000;
+  int multipathEnabled = 0;
+  double hysteresisPercentage = 0.0;
+  double hysteresisExitPercentage = 0.0;
+  int minDwellTime = 0;
+  int flapPenaltyHalfLife = 0;
+  int predictiveHorizon = 0;
+  int confidenceHalfLife = 0;
+  int bandwidthBuckets = 50;
+  double bandwidthEwmaGain = 0.0;
+  int failoverProbeTimeouts = 3;
   std::string topologyFile = "scenarios/topologies/PIPS-topology.txt";
 
   // Defining main prefixes
@@ -71,7 +82,7 @@ main(int argc, char* argv[])
   // Read Parameters
   CommandLine cmd;
   cmd.AddValue("queueName", "Name of the queue to use", queue);
-  cmd.AddValue("forwardingStrategy", "Used forwarding strategy on all nodes", forwardingStrategy);
+  cmd.AddValue("forwardingStrategy", "Used forwarding strategy on all nodes (lowest-cost|bandit)", forwardingStrategy);
   cmd.AddValue("logDir", "Folder where logfiles are stored", logDir);
   cmd.AddValue("approach", "Approach to simulate (push|prerequest|standard). Default: push", approach);
   cmd.AddValue("piRefreshFrequency", "Number of Refresh Persistent Interests per Second", piRefreshFrequency);
@@ -88,6 +99,16 @@ main(int argc, char* argv[])
   cmd.AddValue("requirementMaxLoss", "Maximum loss allowed for well-performing paths (non-inclusive)", requirementMaxLoss);
   cmd.AddValue("requirementMinBandwidth", "Minimum bandwidth allowed for well-performing paths (non-inclusive)", requirementMinBandwidth);
   cmd.AddValue("rttTimeTableMaxDuration", "Maximum waiting time for data packets (rtt calculation)", rttTimeTableMaxDuration);
+  cmd.AddValue("multipathEnabled", "Enables/disables splitting the workload over all well-performing paths", multipathEnabled);
+  cmd.AddValue("hysteresisPercentage", "Percentage by which a path must be better than the limits to be switched to", hysteresisPercentage);
+  cmd.AddValue("hysteresisExitPercentage", "Percentage by which the working path may exceed the limits before it is left", hysteresisExitPercentage);
+  cmd.AddValue("minDwellTime", "Minimum time in milliseconds a working path is kept after a switch", minDwellTime);
+  cmd.AddValue("flapPenaltyHalfLife", "Half-life in milliseconds of the flap penalty (0 disables it)", flapPenaltyHalfLife);
+  cmd.AddValue("predictiveHorizon", "Time in milliseconds ahead a delay or loss trend may not cross the limits (0 disables it)", predictiveHorizon);
+  cmd.AddValue("confidenceHalfLife", "Half-life in milliseconds of the confidence in estimates of faces that are no longer measured (0 disables it)", confidenceHalfLife);
+  cmd.AddValue("bandwidthBuckets", "Number of time buckets the window of the bandwidth estimators is divided into", bandwidthBuckets);
+  cmd.AddValue("bandwidthEwmaGain", "Gain per second of the moving average over the windowed bandwidth (0 disables it)", bandwidthEwmaGain);
+  cmd.AddValue("failoverProbeTimeouts", "Number of consecutive probe timeouts after which the working path counts as failed (0 disables it)", failoverProbeTimeouts);
   cmd.AddValue("topologyFile", "Path to the topology file", topologyFile);
   cmd.Parse(argc, argv);
 
@@ -102,6 +123,16 @@ main(int argc, char* argv[])
   ParameterConfiguration::getInstance()->setParameter("REQUIREMENT_MAXLOSS", requirementMaxLoss, prefixA);
   ParameterConfiguration::getInstance()->setParameter("REQUIREMENT_MINBANDWIDTH", requirementMinBandwidth, prefixA);
   ParameterConfiguration::getInstance()->setParameter("RTT_TIME_TABLE_MAX_DURATION", rttTimeTableMaxDuration, prefixA);
+  ParameterConfiguration::getInstance()->setParameter("MULTIPATH_ENABLED", multipathEnabled, prefixA);
+  ParameterConfiguration::getInstance()->setParameter("HYSTERESIS_PERCENTAGE", hysteresisPercentage, prefixA);
+  ParameterConfiguration::getInstance()->setParameter("HYSTERESIS_EXIT_PERCENTAGE", hysteresisExitPercentage, prefixA);
+  ParameterConfiguration::getInstance()->setParameter("MIN_DWELL_TIME", minDwellTime, prefixA);
+  ParameterConfiguration::getInstance()->setParameter("FLAP_PENALTY_HALF_LIFE", flapPenaltyHalfLife, prefixA);
+  ParameterConfiguration::getInstance()->setParameter("PREDICTIVE_HORIZON", predictiveHorizon, prefixA);
+  ParameterConfiguration::getInstance()->setParameter("CONFIDENCE_HALF_LIFE", confidenceHalfLife, prefixA);
+  ParameterConfiguration::getInstance()->setParameter("BANDWIDTH_BUCKETS", bandwidthBuckets, prefixA);
+  ParameterConfiguration::getInstance()->setParameter("BANDWIDTH_EWMA_GAIN", bandwidthEwmaGain, prefixA);
+  ParameterConfiguration::getInstance()->setParameter("FAILOVER_PROBE_TIMEOUTS", failoverProbeTimeouts, prefixA);
 
   ParameterConfiguration::getInstance()->setParameter("PREFIX_OFFSET", prefixOffset, prefixB);
   ParameterConfiguration::getInstance()->setParameter("TAINTING_ENABLED", taintingEnabled, prefixB);
@@ -111,6 +142,16 @@ main(int argc, char* argv[])
   ParameterConfiguration::getInstance()->setParameter("REQUIREMENT_MAXLOSS", requirementMaxLoss, prefixB);
   ParameterConfiguration::getInstance()->setParameter("REQUIREMENT_MINBANDWIDTH", requirementMinBandwidth, prefixB);
   ParameterConfiguration::getInstance()->setParameter("RTT_TIME_TABLE_MAX_DURATION", rttTimeTableMaxDuration, prefixB);
+  ParameterConfiguration::getInstance()->setParameter("MULTIPATH_ENABLED", multipathEnabled, prefixB);
+  ParameterConfiguration::getInstance()->setParameter("HYSTERESIS_PERCENTAGE", hysteresisPercentage, prefixB);
+  ParameterConfiguration::getInstance()->setParameter("HYSTERESIS_EXIT_PERCENTAGE", hysteresisExitPercentage, prefixB);
+  ParameterConfiguration::getInstance()->setParameter("MIN_DWELL_TIME", minDwellTime, prefixB);
+  ParameterConfiguration::getInstance()->setParameter("FLAP_PENALTY_HALF_LIFE", flapPenaltyHalfLife, prefixB);
+  ParameterConfiguration::getInstance()->setParameter("PREDICTIVE_HORIZON", predictiveHorizon, prefixB);
+  ParameterConfiguration::getInstance()->setParameter("CONFIDENCE_HALF_LIFE", confidenceHalfLife, prefixB);
+  ParameterConfiguration::getInstance()->setParameter("BANDWIDTH_BUCKETS", bandwidthBuckets, prefixB);
+  ParameterConfiguration::getInstance()->setParameter("BANDWIDTH_EWMA_GAIN", bandwidthEwmaGain, prefixB);
+  ParameterConfiguration::getInstance()->setParameter("FAILOVER_PROBE_TIMEOUTS", failoverProbeTimeouts, prefixB);
 
 
   // RNG handling
@@ -155,6 +196,16 @@ main(int argc, char* argv[])
   std::cout << "requirementMaxLoss: " << requirementMaxLoss << std::endl;
   std::cout << "requirementMinBandwidth: " << requirementMinBandwidth << std::endl;
   std::cout << "rttTimeTableMaxDuration: " << rttTimeTableMaxDuration << std::endl;
+  std::cout << "multipathEnabled: " << multipathEnabled << std::endl;
+  std::cout << "hysteresisPercentage: " << hysteresisPercentage << std::endl;
+  std::cout << "hysteresisExitPercentage: " << hysteresisExitPercentage << std::endl;
+  std::cout << "minDwellTime: " << minDwellTime << std::endl;
+  std::cout << "flapPenaltyHalfLife: " << flapPenaltyHalfLife << std::endl;
+  std::cout << "predictiveHorizon: " << predictiveHorizon << std::endl;
+  std::cout << "confidenceHalfLife: " << confidenceHalfLife << std::endl;
+  std::cout << "bandwidthBuckets: " << bandwidthBuckets << std::endl;
+  std::cout << "bandwidthEwmaGain: " << bandwidthEwmaGain << std::endl;
+  std::cout << "failoverProbeTimeouts: " << failoverProbeTimeouts << std::endl;
   std::cout << std::endl;
 
   // Read topology
@@ -300,6 +351,16 @@ main(int argc, char* argv[])
   Simulator::Stop(MilliSeconds(simTime));
 
   Simulator::Run();
+
+  // Report the path selection of every node (probe overhead, switches and requirement violations)
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); ++node) {
+    nfd::fw::Strategy& effectiveStrategy = (*node)->GetObject<ndn::L3Protocol>()->getForwarder()
+                                    ->getStrategyChoice().findEffectiveStrategy(prefixA);
+    nfd::fw::PathSelectionReporter* reporter = dynamic_cast<nfd::fw::PathSelectionReporter*>(&effectiveStrategy);
+    if (reporter != nullptr) {
+      reporter->printPathSelectionStats(std::cout, "PathSelection node=" + Names::FindName(*node));
+    }
+  }
   Simulator::Destroy();
 
   return 0;